@@ -0,0 +1,216 @@
+/*
+ * BitSlicedIndex.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "BitSlicedIndex.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BIT_SLICED_INDEX_X86 1
+#else
+#define BIT_SLICED_INDEX_X86 0
+#endif
+
+// sets the BitSlicedIndexTileWords words of 'bitmap' for each tile to the
+//	AND of the 'required' columns, without the OR of the 'forbidden' columns
+typedef void (*column_kernel_t)(const uint64_t *tiles, size_t num_tiles,
+								const int *required, int num_required,
+								const int *forbidden, int num_forbidden,
+								uint64_t *bitmap);
+
+constexpr size_t BitSlicedIndexTileSize = BitSlicedIndexColumns * BitSlicedIndexTileWords;
+
+// the column of each bit of a letter mask, or -1 if it has none
+static int columnOf(int bit) {
+	if (bit < NumberOfLetters)
+		return bit;
+	return (letter_mask_t(1) << bit) == LetterMaskInvalid ? NumberOfLetters : -1;
+}
+
+/* ************************************************************	*/
+/*							scalar kernel						*/
+/* ************************************************************	*/
+
+static void matchColumnsScalar(const uint64_t *tiles, size_t num_tiles,
+							   const int *required, int num_required,
+							   const int *forbidden, int num_forbidden,
+							   uint64_t *bitmap) {
+
+	for (size_t tile = 0; tile != num_tiles; tile++) {
+		const uint64_t *columns = tiles + tile * BitSlicedIndexTileSize;
+		for (size_t word = 0; word != BitSlicedIndexTileWords; word++) {
+			uint64_t keep = ~uint64_t(0);
+			uint64_t drop = 0;
+			for (int i = 0; i != num_required; i++) {
+				keep &= columns[required[i] * BitSlicedIndexTileWords + word];
+			}
+			for (int i = 0; i != num_forbidden; i++) {
+				drop |= columns[forbidden[i] * BitSlicedIndexTileWords + word];
+			}
+			bitmap[tile * BitSlicedIndexTileWords + word] = keep & ~drop;
+		}
+	}
+}
+
+#if BIT_SLICED_INDEX_X86
+
+/* ************************************************************	*/
+/*							AVX2 kernel							*/
+/* ************************************************************	*/
+
+// 256 words per instruction
+__attribute__((target("avx2")))
+static void matchColumnsAvx2(const uint64_t *tiles, size_t num_tiles,
+							 const int *required, int num_required,
+							 const int *forbidden, int num_forbidden,
+							 uint64_t *bitmap) {
+
+	for (size_t tile = 0; tile != num_tiles; tile++) {
+		const uint64_t *columns = tiles + tile * BitSlicedIndexTileSize;
+		__m256i keep_low = _mm256_set1_epi64x(-1);
+		__m256i keep_high = keep_low;
+		__m256i drop_low = _mm256_setzero_si256();
+		__m256i drop_high = drop_low;
+		for (int i = 0; i != num_required; i++) {
+			const __m256i *column = reinterpret_cast<const __m256i *>(
+					columns + required[i] * BitSlicedIndexTileWords);
+			keep_low = _mm256_and_si256(keep_low, _mm256_loadu_si256(column));
+			keep_high = _mm256_and_si256(keep_high, _mm256_loadu_si256(column + 1));
+		}
+		for (int i = 0; i != num_forbidden; i++) {
+			const __m256i *column = reinterpret_cast<const __m256i *>(
+					columns + forbidden[i] * BitSlicedIndexTileWords);
+			drop_low = _mm256_or_si256(drop_low, _mm256_loadu_si256(column));
+			drop_high = _mm256_or_si256(drop_high, _mm256_loadu_si256(column + 1));
+		}
+		__m256i *out = reinterpret_cast<__m256i *>(bitmap + tile * BitSlicedIndexTileWords);
+		_mm256_storeu_si256(out, _mm256_andnot_si256(drop_low, keep_low));
+		_mm256_storeu_si256(out + 1, _mm256_andnot_si256(drop_high, keep_high));
+	}
+}
+
+/* ************************************************************	*/
+/*							AVX-512 kernel						*/
+/* ************************************************************	*/
+
+// 512 words per instruction
+__attribute__((target("avx512f")))
+static void matchColumnsAvx512(const uint64_t *tiles, size_t num_tiles,
+							   const int *required, int num_required,
+							   const int *forbidden, int num_forbidden,
+							   uint64_t *bitmap) {
+
+	for (size_t tile = 0; tile != num_tiles; tile++) {
+		const uint64_t *columns = tiles + tile * BitSlicedIndexTileSize;
+		__m512i keep = _mm512_set1_epi64(-1);
+		__m512i drop = _mm512_setzero_si512();
+		for (int i = 0; i != num_required; i++) {
+			keep = _mm512_and_si512(keep, _mm512_loadu_si512(columns + required[i] * BitSlicedIndexTileWords));
+		}
+		for (int i = 0; i != num_forbidden; i++) {
+			drop = _mm512_or_si512(drop, _mm512_loadu_si512(columns + forbidden[i] * BitSlicedIndexTileWords));
+		}
+		__m512i allowed = _mm512_xor_si512(drop, _mm512_set1_epi64(-1));
+		_mm512_storeu_si512(bitmap + tile * BitSlicedIndexTileWords, _mm512_and_si512(keep, allowed));
+	}
+}
+
+#endif
+
+/* ************************************************************	*/
+/*							dispatch							*/
+/* ************************************************************	*/
+
+static column_kernel_t selectColumnKernel(void) {
+
+#if BIT_SLICED_INDEX_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return matchColumnsAvx512;
+	if (__builtin_cpu_supports("avx2"))
+		return matchColumnsAvx2;
+#endif
+	return matchColumnsScalar;
+}
+
+/* ************************************************************	*/
+/*							BitSlicedIndex						*/
+/* ************************************************************	*/
+
+void BitSlicedIndex::build(const LetterMaskIndex &index) {
+
+	m_num_words = index.size();
+	m_num_tiles = (m_num_words + BitSlicedIndexTileIds - 1) / BitSlicedIndexTileIds;
+	m_tiles.assign(m_num_tiles * BitSlicedIndexTileSize, 0);
+
+	for (size_t i = 0; i != m_num_words; i++) {
+		uint64_t *columns = &m_tiles[(i / BitSlicedIndexTileIds) * BitSlicedIndexTileSize];
+		size_t word = (i % BitSlicedIndexTileIds) / 64;
+		uint64_t bit = uint64_t(1) << (i % 64);
+		for (letter_mask_t bits = index.mask(i); bits != 0; bits &= bits - 1) {
+			int column = columnOf(__builtin_ctz(bits));
+			if (column >= 0)
+				columns[column * BitSlicedIndexTileWords + word] |= bit;
+		}
+	}
+}
+
+void BitSlicedIndex::clear(void) {
+
+	m_tiles.clear();
+	m_num_tiles = 0;
+	m_num_words = 0;
+}
+
+size_t BitSlicedIndex::find(letter_mask_t allowed, letter_mask_t required,
+							std::vector<word_id_t> &matches) const {
+
+	// chosen once, the first time a search is done
+	static const column_kernel_t kernel = selectColumnKernel();
+
+	size_t first_match = matches.size();
+
+	if ((required & ~allowed) != 0)
+		return 0;
+
+	int required_columns[BitSlicedIndexColumns];
+	int forbidden_columns[BitSlicedIndexColumns];
+	int num_required = 0;
+	int num_forbidden = 0;
+	for (int bit = 0; bit != 32; bit++) {
+		int column = columnOf(bit);
+		if (column < 0)
+			continue;
+		letter_mask_t letter = letter_mask_t(1) << bit;
+		if (required & letter)
+			required_columns[num_required++] = column;
+		else if ((allowed & letter) == 0)
+			forbidden_columns[num_forbidden++] = column;
+	}
+
+	uint64_t bitmap[BitSlicedIndexTilesPerBlock * BitSlicedIndexTileWords];
+	for (size_t first_tile = 0; first_tile < m_num_tiles; first_tile += BitSlicedIndexTilesPerBlock) {
+		size_t num_tiles = std::min(BitSlicedIndexTilesPerBlock, m_num_tiles - first_tile);
+		kernel(m_tiles.data() + first_tile * BitSlicedIndexTileSize, num_tiles,
+			   required_columns, num_required, forbidden_columns, num_forbidden, bitmap);
+
+		// the ids past the last word of the last tile are not words
+		size_t first_id = first_tile * BitSlicedIndexTileIds;
+		size_t num_bitmap_words = std::min(num_tiles * BitSlicedIndexTileWords,
+										   (m_num_words - first_id + 63) / 64);
+		for (size_t i = 0; i != num_bitmap_words; i++) {
+			for (uint64_t bits = bitmap[i]; bits != 0; bits &= bits - 1) {
+				size_t id = first_id + i * 64 + __builtin_ctzll(bits);
+				if (id < m_num_words)
+					matches.push_back(static_cast<word_id_t>(id));
+			}
+		}
+	}
+
+	return matches.size() - first_match;
+}
@@ -0,0 +1,59 @@
+/*
+ * BitSlicedIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef BITSLICEDINDEX_H_
+#define BITSLICEDINDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "LetterMask.h"
+#include "LetterMaskIndex.h"
+#include "SearchEngine.h"
+#include "SpellingBeeSolver.h"
+
+// one column per letter, plus one for the words with a character that is not a letter
+constexpr int BitSlicedIndexColumns = NumberOfLetters + 1;
+// the ids of a tile fill one AVX-512 register per column
+constexpr size_t BitSlicedIndexTileWords = 8;
+constexpr size_t BitSlicedIndexTileIds = BitSlicedIndexTileWords * 64;
+// number of tiles matched into a bitmap at a time
+constexpr size_t BitSlicedIndexTilesPerBlock = 64;
+
+// The letter masks of a LetterMaskIndex turned on their side: for each
+//	letter, a bit per word that is set if the word uses the letter
+//
+//	A search ORs together the columns of the letters that are not allowed,
+//	ANDs together the columns of the required letters, and takes the
+//	one from the other, for 512 words per instruction with AVX-512 and
+//	without looking at any word on its own.  The columns are stored a
+//	tile of 512 words at a time, so a search reads the index in order
+class BitSlicedIndex: public SearchEngine {
+private:
+	// tile t, column c is m_tiles[(t * BitSlicedIndexColumns + c) * BitSlicedIndexTileWords]
+	std::vector<uint64_t> m_tiles;
+	size_t m_num_tiles;
+	size_t m_num_words;
+
+public:
+	BitSlicedIndex() :
+		m_num_tiles(0),
+		m_num_words(0) {}
+	virtual ~BitSlicedIndex() {}
+
+	void build(const LetterMaskIndex &index);
+	void clear(void);
+
+	size_t size(void) const			{ return m_num_words; }
+	// the number of bytes the columns take
+	size_t memoryUsed(void) const	{ return m_tiles.size() * sizeof(uint64_t); }
+
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches) const;
+};
+
+#endif /* BITSLICEDINDEX_H_ */
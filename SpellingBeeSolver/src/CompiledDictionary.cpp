@@ -0,0 +1,390 @@
+/*
+ * CompiledDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "CompiledDictionary.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Hash.h"
+
+// sections start on 8 byte boundaries
+static uint64_t alignSection(uint64_t offset) {
+	return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+CompiledDictionary::CompiledDictionary() :
+	m_filename(""),
+	m_header(nullptr),
+	m_offsets(nullptr),
+	m_lengths(nullptr),
+	m_masks(nullptr),
+	m_pool(nullptr),
+	m_next_word(0),
+	m_state(CompiledDictionaryState::FILE_NOT_MAPPED) {}
+
+CompiledDictionary::~CompiledDictionary() {
+	unmap();
+}
+
+CompiledDictionary::CompiledDictionary(const std::string filename) :
+	m_filename(filename),
+	m_header(nullptr),
+	m_offsets(nullptr),
+	m_lengths(nullptr),
+	m_masks(nullptr),
+	m_pool(nullptr),
+	m_next_word(0),
+	m_state(CompiledDictionaryState::FILE_NOT_MAPPED) {
+
+	map();
+}
+
+bool CompiledDictionary::map(void) {
+
+	if (!m_file.map(m_filename)) {
+		m_state = CompiledDictionaryState::FILE_OPEN_ERROR;
+		return false;
+	}
+
+	m_state = CompiledDictionaryState::FILE_FORMAT_ERROR;
+
+	if (m_file.size() < sizeof(CompiledDictionaryHeader))
+		return false;
+
+	const CompiledDictionaryHeader *header =
+			reinterpret_cast<const CompiledDictionaryHeader *>(m_file.data());
+
+	if (memcmp(header->magic, CompiledDictionaryMagic, sizeof(header->magic)) != 0 ||
+		header->version != CompiledDictionaryVersion ||
+		header->byte_order != CompiledDictionaryByteOrder ||
+		header->file_size != m_file.size())
+		return false;
+
+	// every section must lie, aligned, within the file
+	//	the sizes are checked by division so that they cannot overflow
+	uint64_t n = header->num_words;
+	uint64_t file_size = header->file_size;
+	struct {
+		uint64_t offset;
+		uint64_t element_size;
+		uint64_t count;
+	} sections[] = {
+		{ header->offsets_offset,	sizeof(uint32_t),		n },
+		{ header->lengths_offset,	sizeof(word_length_t),	n },
+		{ header->masks_offset,		sizeof(letter_mask_t),	n },
+		{ header->pool_offset,		sizeof(char),			header->pool_size },
+	};
+	for (auto &section : sections) {
+		if (section.offset != alignSection(section.offset) ||
+			section.offset < sizeof(CompiledDictionaryHeader) ||
+			section.offset > file_size ||
+			section.count > (file_size - section.offset) / section.element_size)
+			return false;
+	}
+
+	const uint32_t *offsets = reinterpret_cast<const uint32_t *>(m_file.data() + header->offsets_offset);
+	const word_length_t *lengths = reinterpret_cast<const word_length_t *>(m_file.data() + header->lengths_offset);
+
+	// every word must lie within the pool, so a damaged file cannot
+	//	send word() outside of the mapping.  the checksum is left to verify()
+	//	the furthest end is found without a branch, so the loop vectorizes
+	uint64_t end_of_words = 0;
+	for (uint64_t i = 0; i < n; i++) {
+		end_of_words = std::max(end_of_words, uint64_t(offsets[i]) + lengths[i]);
+	}
+	if (end_of_words > header->pool_size)
+		return false;
+
+	m_header = header;
+	m_offsets = offsets;
+	m_lengths = lengths;
+	m_masks = reinterpret_cast<const letter_mask_t *>(m_file.data() + header->masks_offset);
+	m_pool = m_file.data() + header->pool_offset;
+	m_next_word = 0;
+	m_state = CompiledDictionaryState::FILE_MAPPED;
+	return true;
+}
+
+void CompiledDictionary::unmap(void) {
+
+	m_file.unmap();
+	m_header = nullptr;
+	m_offsets = nullptr;
+	m_lengths = nullptr;
+	m_masks = nullptr;
+	m_pool = nullptr;
+	m_next_word = 0;
+	m_state = CompiledDictionaryState::FILE_NOT_MAPPED;
+}
+
+//	functions inherited from base class Dictionary
+bool CompiledDictionary::open(void) {
+
+	if (isOpen())
+		return begining();
+
+	if (m_filename.empty())
+		return false;
+
+	return map();
+}
+
+bool CompiledDictionary::close(void) {
+
+	unmap();
+	return true;
+}
+
+bool CompiledDictionary::begining(void) {
+
+	if (!isOpen())
+		return false;
+
+	m_next_word = 0;
+	return true;
+}
+
+std::string CompiledDictionary::nextWord(void) {
+
+	std::string_view view;
+	if (!nextWordView(view))
+		return std::string("");
+
+	return std::string(view);
+}
+
+bool CompiledDictionary::nextWordView(std::string_view &view) {
+
+	if (!isNext())
+		return false;
+
+	view = word(m_next_word++);
+	return true;
+}
+
+size_t CompiledDictionary::nextWords(std::span<std::string_view> words) {
+
+	size_t num_words = 0;
+	while (num_words != words.size() && isNext()) {
+		words[num_words++] = word(m_next_word++);
+	}
+	return num_words;
+}
+
+bool CompiledDictionary::isError(void) const {
+	return m_state == CompiledDictionaryState::FILE_OPEN_ERROR ||
+		   m_state == CompiledDictionaryState::FILE_FORMAT_ERROR;
+}
+
+bool CompiledDictionary::isOpen(void) const {
+	return m_state == CompiledDictionaryState::FILE_MAPPED;
+}
+
+bool CompiledDictionary::isNext(void) const {
+	return isOpen() && m_next_word < m_header->num_words;
+}
+
+//	functions specific to this class
+std::string CompiledDictionary::filename(void) const {
+	return m_filename;
+}
+
+CompiledDictionaryState CompiledDictionary::getState() const {
+	return m_state;
+}
+
+uint64_t CompiledDictionary::size(void) const {
+	return isOpen() ? m_header->num_words : 0;
+}
+
+const CompiledDictionarySource &CompiledDictionary::source(void) const {
+	static const CompiledDictionarySource no_source = { 0, 0, 0 };
+	return isOpen() ? m_header->source : no_source;
+}
+
+bool CompiledDictionary::attachIndex(LetterMaskIndex &index) const {
+
+	if (!isOpen())
+		return false;
+
+	index.attach(std::string_view(m_pool, m_header->pool_size),
+				 m_offsets, m_lengths, m_masks, m_header->num_words);
+	return true;
+}
+
+bool CompiledDictionary::verify(void) const {
+
+	if (!isOpen())
+		return false;
+
+	size_t header_size = sizeof(CompiledDictionaryHeader);
+	return fnv1a(m_file.data() + header_size, m_file.size() - header_size) ==
+		   m_header->checksum;
+}
+
+bool CompiledDictionary::isCompiledDictionary(const std::string &filename) {
+
+	// reading the magic from a pipe would lose the words it was part of
+	struct stat file_status;
+	if (stat(filename.c_str(), &file_status) != 0 || !S_ISREG(file_status.st_mode))
+		return false;
+
+	std::ifstream file(filename, std::ios::binary);
+	char magic[sizeof(CompiledDictionaryMagic)];
+	if (!file.read(magic, sizeof(magic)))
+		return false;
+
+	return memcmp(magic, CompiledDictionaryMagic, sizeof(magic)) == 0;
+}
+
+bool CompiledDictionary::describeSource(const std::string &filename,
+										CompiledDictionarySource &source) {
+
+	return statSource(filename, source) && hashSource(filename, source);
+}
+
+bool CompiledDictionary::statSource(const std::string &filename,
+									CompiledDictionarySource &source) {
+
+	struct stat file_status;
+	if (stat(filename.c_str(), &file_status) != 0 || !S_ISREG(file_status.st_mode))
+		return false;
+
+	source.size = file_status.st_size;
+	source.mtime = static_cast<int64_t>(file_status.st_mtim.tv_sec) * 1000000000 +
+				   file_status.st_mtim.tv_nsec;
+	source.hash = 0;
+	return true;
+}
+
+// the size and modification time catch almost every change, the hash
+//	catches an edit that keeps both, so it is taken over the whole file
+bool CompiledDictionary::hashSource(const std::string &filename,
+									CompiledDictionarySource &source) {
+
+	int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	std::string block(CompiledDictionarySourceBlockSize, '\0');
+	uint64_t hash = fnv1a(&source.size, sizeof(source.size));
+	uint64_t offset = 0;
+	bool is_read = true;
+	while (offset != source.size && is_read) {
+		uint64_t block_size = std::min(CompiledDictionarySourceBlockSize, source.size - offset);
+		is_read = pread(fd, block.data(), block_size, offset) ==
+				  static_cast<ssize_t>(block_size);
+		hash = fnv1a(block.data(), block_size, hash);
+		offset += block_size;
+	}
+	::close(fd);
+
+	source.hash = hash;
+	return is_read;
+}
+
+bool CompiledDictionary::write(const LetterMaskIndex &index,
+							   const CompiledDictionarySource &source,
+							   const std::string &filename) {
+
+	uint64_t n = index.size();
+
+	CompiledDictionaryHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CompiledDictionaryMagic, sizeof(header.magic));
+	header.version = CompiledDictionaryVersion;
+	header.byte_order = CompiledDictionaryByteOrder;
+	header.num_words = n;
+	header.source = source;
+
+	// the words are copied into a pool of their own, since an index
+	//	that refers to a text file has newlines between its words
+	std::string pool;
+	std::vector<uint32_t> offsets(n);
+	std::vector<word_length_t> lengths(n);
+	std::vector<letter_mask_t> masks(n);
+	for (uint64_t i = 0; i != n; i++) {
+		std::string_view word = index.word(i);
+		if (pool.size() + word.size() > UINT32_MAX)
+			return false;
+		offsets[i] = static_cast<uint32_t>(pool.size());
+		lengths[i] = index.length(i);
+		masks[i] = index.mask(i);
+		pool.append(word);
+	}
+
+	header.offsets_offset = alignSection(sizeof(header));
+	header.lengths_offset = alignSection(header.offsets_offset + n * sizeof(uint32_t));
+	header.masks_offset = alignSection(header.lengths_offset + n * sizeof(word_length_t));
+	header.pool_offset = alignSection(header.masks_offset + n * sizeof(letter_mask_t));
+	header.pool_size = pool.size();
+	header.file_size = header.pool_offset + header.pool_size;
+
+	// everything after the header, including the padding between sections
+	std::string body(header.file_size - sizeof(header), '\0');
+	memcpy(&body[header.offsets_offset - sizeof(header)], offsets.data(), n * sizeof(uint32_t));
+	memcpy(&body[header.lengths_offset - sizeof(header)], lengths.data(), n * sizeof(word_length_t));
+	memcpy(&body[header.masks_offset - sizeof(header)], masks.data(), n * sizeof(letter_mask_t));
+	memcpy(&body[header.pool_offset - sizeof(header)], pool.data(), pool.size());
+	header.checksum = fnv1a(body.data(), body.size());
+
+	// readers either see the old file or the complete new one
+	std::string temporary = filename + ".tmp." + std::to_string(getpid());
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(body.data(), body.size());
+		file.close();
+		if (!file) {
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+
+	if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+/* ************************************************************	*/
+/*					enum class CompiledDictionaryState			*/
+/* ************************************************************	*/
+
+#undef COMPILED_DICTIONARY_STATE
+#define COMPILED_DICTIONARY_STATE(e) #e,
+static std::string CompiledDictionaryStateStrings[] = {
+		COMPILED_DICTIONARY_STATES
+};
+
+static bool isValid(CompiledDictionaryState state) {
+	switch(state) {
+	case CompiledDictionaryState::FILE_NOT_MAPPED:
+	case CompiledDictionaryState::FILE_MAPPED:
+	case CompiledDictionaryState::FILE_OPEN_ERROR:
+	case CompiledDictionaryState::FILE_FORMAT_ERROR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::string toString(CompiledDictionaryState state) {
+	if (isValid(state)) {
+		int i = static_cast<int>(state);
+		return CompiledDictionaryStateStrings[i];
+	}
+	return "INVALID CompiledDictionaryState";
+}
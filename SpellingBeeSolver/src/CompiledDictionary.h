@@ -0,0 +1,163 @@
+/*
+ * CompiledDictionary.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef COMPILEDDICTIONARY_H_
+#define COMPILEDDICTIONARY_H_
+
+#include "Dictionary.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "LetterMaskIndex.h"
+#include "MappedFile.h"
+#include "SpellingBeeSolver.h"
+
+/*	A compiled dictionary (.sbd) is a LetterMaskIndex saved to disk, so that
+ *	loading it is an mmap rather than a parse of a text dictionary
+ *
+ *	The file is a CompiledDictionaryHeader followed by four sections, each
+ *	starting on an 8 byte boundary, at the file offsets given in the header
+ *		uint32_t		offsets[num_words]	offset of each word in the pool
+ *		word_length_t	lengths[num_words]
+ *		letter_mask_t	masks[num_words]
+ *		char			pool[pool_size]		the words, back to back
+ *	All numbers are in the byte order of the machine that wrote the file,
+ *	which is recorded in the header so that a mismatch is detected.
+ *	The checksum is the FNV-1a hash of every byte after the header
+ *
+ *	Loading checks the header and the bounds of the sections, which takes
+ *	no time, and then that every word lies within the pool, which is one
+ *	pass over the offsets and lengths, 6 bytes a word.  That pass, rather
+ *	than the checksum, is what keeps a damaged file from being read outside
+ *	of its mapping.  The checksum reads the whole file, so it is only
+ *	checked by verify(), which --compile-dict runs on every file it writes.
+ *	A file damaged within its bounds loads, and may give wrong answers
+ */
+
+constexpr char CompiledDictionaryMagic[4] = { 'S', 'B', 'D', '\0' };
+constexpr uint32_t CompiledDictionaryVersion = 2;
+constexpr uint32_t CompiledDictionaryByteOrder = 0x01020304;
+constexpr const char *CompiledDictionaryExtension = ".sbd";
+// the hash of a text dictionary is taken over all of it, read in blocks of this size
+constexpr uint64_t CompiledDictionarySourceBlockSize = 65536;
+
+// the text dictionary a compiled dictionary was made from
+struct CompiledDictionarySource {
+	uint64_t size;
+	// last modification time, in nanoseconds since the epoch
+	int64_t mtime;
+	// FNV-1a hash of the size followed by the whole of the contents
+	uint64_t hash;
+};
+
+struct CompiledDictionaryHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t reserved;
+	uint64_t file_size;
+	uint64_t num_words;
+	uint64_t offsets_offset;
+	uint64_t lengths_offset;
+	uint64_t masks_offset;
+	uint64_t pool_offset;
+	uint64_t pool_size;
+	CompiledDictionarySource source;
+	uint64_t checksum;
+};
+
+#undef COMPILED_DICTIONARY_STATE
+#define COMPILED_DICTIONARY_STATES \
+	COMPILED_DICTIONARY_STATE(FILE_NOT_MAPPED)\
+	COMPILED_DICTIONARY_STATE(FILE_MAPPED)\
+	COMPILED_DICTIONARY_STATE(FILE_OPEN_ERROR)\
+	COMPILED_DICTIONARY_STATE(FILE_FORMAT_ERROR)
+
+#define COMPILED_DICTIONARY_STATE(e)	e,
+
+enum class CompiledDictionaryState {
+	COMPILED_DICTIONARY_STATES
+};
+
+std::string toString(CompiledDictionaryState state);
+
+class CompiledDictionary: public Dictionary {
+private:
+	std::string m_filename;
+	MappedFile m_file;
+	const CompiledDictionaryHeader *m_header;
+	const uint32_t *m_offsets;
+	const word_length_t *m_lengths;
+	const letter_mask_t *m_masks;
+	const char *m_pool;
+	uint64_t m_next_word;
+	CompiledDictionaryState m_state;
+
+	CompiledDictionary();
+	// maps the file, and checks that the header describes sections
+	//	that lie within it, and that every word lies within the pool
+	//	The checksum is not checked, see verify()
+	bool map(void);
+	void unmap(void);
+	std::string_view word(uint64_t i) const {
+		return std::string_view(m_pool + m_offsets[i], m_lengths[i]);
+	}
+
+public:
+	virtual ~CompiledDictionary();
+	// copying disallowed so that only one object owns the mapping
+	CompiledDictionary(const CompiledDictionary &other) = delete;
+	CompiledDictionary& operator=(const CompiledDictionary &other) = delete;
+
+	//	Resource Acquisition is Initialization
+	CompiledDictionary(const std::string filename);
+
+	/*	**********************************************	*/
+	/*	functions inherited from base class Dictionary  */
+	/* 	**********************************************	*/
+
+	bool open(void);
+	bool close(void);
+	bool begining(void);
+	std::string nextWord(void);
+	// the view is into the mapping, and is valid until the file is closed
+	bool nextWordView(std::string_view &word);
+	size_t nextWords(std::span<std::string_view> words);
+	bool isError(void) const;
+	bool isOpen(void) const;
+	bool isNext(void) const;
+
+	//	functions specific to this class
+	std::string filename(void) const;
+	CompiledDictionaryState getState() const;
+	uint64_t size(void) const;
+	const CompiledDictionarySource &source(void) const;
+	// points 'index' at the arrays in the mapping, which must stay open
+	//	for as long as the index is used
+	bool attachIndex(LetterMaskIndex &index) const;
+	// compares the checksum to the contents, this reads the whole file
+	bool verify(void) const;
+
+	// returns true if 'filename' is a regular file that starts with the
+	//	compiled dictionary magic
+	static bool isCompiledDictionary(const std::string &filename);
+	// describes the text dictionary 'filename', returns false if it cannot be read
+	static bool describeSource(const std::string &filename, CompiledDictionarySource &source);
+	// sets only the size and modification time of 'source', without reading
+	//	the file, so that a mismatch can be found before it is hashed
+	static bool statSource(const std::string &filename, CompiledDictionarySource &source);
+	// sets the hash of 'source', whose size must already be set
+	static bool hashSource(const std::string &filename, CompiledDictionarySource &source);
+	// writes 'index' to 'filename', replacing it atomically by writing a
+	//	temporary file and renaming it.  Returns false if it could not be written
+	static bool write(const LetterMaskIndex &index, const CompiledDictionarySource &source,
+					  const std::string &filename);
+};
+
+#endif /* COMPILEDDICTIONARY_H_ */
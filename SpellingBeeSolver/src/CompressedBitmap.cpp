@@ -0,0 +1,141 @@
+/*
+ * CompressedBitmap.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "CompressedBitmap.h"
+
+#include <algorithm>
+#include <cstring>
+
+void CompressedBitmap::add(uint32_t value) {
+
+	uint32_t chunk = value >> CompressedBitmapChunkBits;
+	uint16_t low = static_cast<uint16_t>(value);
+	if (chunk >= m_chunks.size())
+		m_chunks.resize(chunk + 1);
+
+	Container &container = m_chunks[chunk];
+	if (!container.bits.empty()) {
+		container.bits[low / 64] |= uint64_t(1) << (low % 64);
+	} else {
+		container.values.push_back(low);
+		// past this size, a bitmap of the whole chunk is smaller
+		if (container.values.size() > CompressedBitmapMaxArraySize) {
+			container.bits.assign(CompressedBitmapChunkWords, 0);
+			for (uint16_t v : container.values) {
+				container.bits[v / 64] |= uint64_t(1) << (v % 64);
+			}
+			std::vector<uint16_t>().swap(container.values);
+		}
+	}
+	m_size++;
+}
+
+void CompressedBitmap::clear(void) {
+
+	m_chunks.clear();
+	m_size = 0;
+}
+
+void CompressedBitmap::shrinkToFit(void) {
+
+	m_chunks.shrink_to_fit();
+	for (Container &container : m_chunks) {
+		container.values.shrink_to_fit();
+	}
+}
+
+size_t CompressedBitmap::memoryUsed(void) const {
+
+	size_t bytes = m_chunks.capacity() * sizeof(Container);
+	for (const Container &container : m_chunks) {
+		bytes += container.values.capacity() * sizeof(uint16_t) +
+				 container.bits.capacity() * sizeof(uint64_t);
+	}
+	return bytes;
+}
+
+std::pair<const uint16_t *, const uint16_t *> CompressedBitmap::arrayRange(
+		const Container &container, uint32_t first_word, uint32_t num_words) {
+
+	const uint16_t *begin = container.values.data();
+	const uint16_t *end = begin + container.values.size();
+	uint32_t first_value = first_word * 64;
+	uint32_t last_value = (first_word + num_words) * 64;
+	if (first_value != 0)
+		begin = std::lower_bound(begin, end, first_value);
+	if (last_value != CompressedBitmapChunkSize)
+		end = std::lower_bound(begin, end, last_value);
+	return std::make_pair(begin, end);
+}
+
+void CompressedBitmap::copyChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+								 uint64_t *bits) const {
+
+	if (chunk < m_chunks.size() && !m_chunks[chunk].bits.empty()) {
+		memcpy(bits, m_chunks[chunk].bits.data() + first_word, num_words * sizeof(uint64_t));
+		return;
+	}
+
+	memset(bits, 0, num_words * sizeof(uint64_t));
+	if (chunk < m_chunks.size()) {
+		auto values = arrayRange(m_chunks[chunk], first_word, num_words);
+		for (const uint16_t *v = values.first; v != values.second; v++) {
+			uint32_t bit = *v - first_word * 64;
+			bits[bit / 64] |= uint64_t(1) << (bit % 64);
+		}
+	}
+}
+
+void CompressedBitmap::andChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+								uint64_t *bits) const {
+
+	if (chunk >= m_chunks.size()) {
+		memset(bits, 0, num_words * sizeof(uint64_t));
+		return;
+	}
+
+	const Container &container = m_chunks[chunk];
+	if (!container.bits.empty()) {
+		const uint64_t *other = container.bits.data() + first_word;
+		for (uint32_t i = 0; i != num_words; i++) {
+			bits[i] &= other[i];
+		}
+		return;
+	}
+
+	// only the bits of the array's values can survive
+	uint64_t kept[CompressedBitmapChunkWords];
+	memset(kept, 0, num_words * sizeof(uint64_t));
+	auto values = arrayRange(container, first_word, num_words);
+	for (const uint16_t *v = values.first; v != values.second; v++) {
+		uint32_t bit = *v - first_word * 64;
+		kept[bit / 64] |= bits[bit / 64] & (uint64_t(1) << (bit % 64));
+	}
+	memcpy(bits, kept, num_words * sizeof(uint64_t));
+}
+
+void CompressedBitmap::andNotChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+								   uint64_t *bits) const {
+
+	if (chunk >= m_chunks.size())
+		return;
+
+	const Container &container = m_chunks[chunk];
+	if (!container.bits.empty()) {
+		const uint64_t *other = container.bits.data() + first_word;
+		for (uint32_t i = 0; i != num_words; i++) {
+			bits[i] &= ~other[i];
+		}
+		return;
+	}
+
+	auto values = arrayRange(container, first_word, num_words);
+	for (const uint16_t *v = values.first; v != values.second; v++) {
+		uint32_t bit = *v - first_word * 64;
+		bits[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * CompressedBitmap.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef COMPRESSEDBITMAP_H_
+#define COMPRESSEDBITMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// values are split into chunks on their high 16 bits
+constexpr int CompressedBitmapChunkBits = 16;
+constexpr uint32_t CompressedBitmapChunkSize = 1u << CompressedBitmapChunkBits;
+// the number of 64 bit words in the bitmap of a whole chunk
+constexpr uint32_t CompressedBitmapChunkWords = CompressedBitmapChunkSize / 64;
+// a chunk with more values than this is smaller stored as a bitmap
+constexpr uint32_t CompressedBitmapMaxArraySize = CompressedBitmapChunkSize / 16;
+
+// A set of 32 bit values, such as word ids, stored the way Roaring bitmaps
+//	store them: each chunk of 2^16 values is either a sorted array of the
+//	low 16 bits of the values in it, if there are few of them, or a bitmap
+//	of the whole chunk if there are many.  A chunk with no values takes
+//	no space at all, so the size follows the number of values rather than
+//	the largest value
+//
+//	Set operations are done a chunk at a time on an uncompressed bitmap
+//	of the chunk, which the bitmap chunks combine with word by word
+class CompressedBitmap {
+private:
+	struct Container {
+		// the low 16 bits of each value, if the container is an array
+		std::vector<uint16_t> values;
+		// CompressedBitmapChunkWords words, if the container is a bitmap
+		std::vector<uint64_t> bits;
+	};
+
+	// indexed by the high 16 bits of the values, empty chunks have no container
+	std::vector<Container> m_chunks;
+	size_t m_size;
+
+	// the part of an array container's values that falls in the words
+	static std::pair<const uint16_t *, const uint16_t *> arrayRange(
+			const Container &container, uint32_t first_word, uint32_t num_words);
+
+public:
+	CompressedBitmap() :
+		m_size(0) {}
+	virtual ~CompressedBitmap() {}
+
+	// values must be added in increasing order
+	void add(uint32_t value);
+	void clear(void);
+	// releases the room left over for adding more values
+	void shrinkToFit(void);
+
+	size_t size(void) const				{ return m_size; }
+	uint32_t numberOfChunks(void) const	{ return m_chunks.size(); }
+	bool isChunkEmpty(uint32_t chunk) const {
+		return chunk >= m_chunks.size() ||
+			   (m_chunks[chunk].values.empty() && m_chunks[chunk].bits.empty());
+	}
+	// the number of bytes the values take
+	size_t memoryUsed(void) const;
+
+	// 'bits' is the bitmap of words first_word .. first_word+num_words-1
+	//	of a chunk, so that part of a chunk can be worked on in the cache
+	//	sets 'bits' to the values of the chunk
+	void copyChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+				   uint64_t *bits) const;
+	// clears the bits of values that are not in the chunk
+	void andChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+				  uint64_t *bits) const;
+	// clears the bits of values that are in the chunk
+	void andNotChunk(uint32_t chunk, uint32_t first_word, uint32_t num_words,
+					 uint64_t *bits) const;
+};
+
+#endif /* COMPRESSEDBITMAP_H_ */
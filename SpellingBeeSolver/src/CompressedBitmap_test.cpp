@@ -0,0 +1,9 @@
+/*
+ * CompressedBitmap_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "CompressedBitmap.h"
+
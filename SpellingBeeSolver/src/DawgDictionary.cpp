@@ -0,0 +1,375 @@
+/*
+ * DawgDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "DawgDictionary.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+DawgDictionary::DawgDictionary() :
+	m_next_word(0),
+	m_is_open(false),
+	m_is_error(false),
+	m_path_started(false) {}
+
+/* ************************************************************	*/
+/*					functions inherited from Dictionary			*/
+/* ************************************************************	*/
+
+bool DawgDictionary::open(void) {
+
+	begining();
+	m_is_open = !m_is_error;
+	return m_is_open;
+}
+
+bool DawgDictionary::close(void) {
+
+	m_is_open = false;
+	return true;
+}
+
+bool DawgDictionary::begining(void) {
+
+	m_next_word = 0;
+	m_path_edges.clear();
+	m_path.clear();
+	m_path_started = false;
+	return true;
+}
+
+std::string DawgDictionary::nextWord(void) {
+
+	std::string_view word;
+	if (!nextWordView(word))
+		return std::string("");
+	return std::string(word);
+}
+
+bool DawgDictionary::nextWordView(std::string_view &word) {
+
+	if (!isNext() || !nextFinalNode())
+		return false;
+	m_next_word++;
+	word = m_path;
+	return true;
+}
+
+// the path buffer is overwritten by the next word, so the words of a
+//	batch are copied end to end, and their views made once all are copied
+size_t DawgDictionary::nextWords(std::span<std::string_view> words) {
+
+	m_batch_text.clear();
+	m_batch_ends.clear();
+	while (m_batch_ends.size() != words.size() && isNext() && nextFinalNode()) {
+		m_next_word++;
+		m_batch_text += m_path;
+		m_batch_ends.push_back(m_batch_text.size());
+	}
+
+	size_t start = 0;
+	for (size_t i = 0; i != m_batch_ends.size(); i++) {
+		words[i] = std::string_view(m_batch_text).substr(start, m_batch_ends[i] - start);
+		start = m_batch_ends[i];
+	}
+	return m_batch_ends.size();
+}
+
+bool DawgDictionary::isError(void) const {
+
+	return m_is_error;
+}
+
+bool DawgDictionary::isOpen(void) const {
+
+	return m_is_open;
+}
+
+bool DawgDictionary::isNext(void) const {
+
+	return m_is_open && m_next_word < size();
+}
+
+/* ************************************************************	*/
+/*					functions inherited from SearchEngine		*/
+/* ************************************************************	*/
+
+size_t DawgDictionary::find(letter_mask_t allowed, letter_mask_t required,
+							std::vector<word_id_t> &matches) const {
+
+	return find(std::string_view(), 0, allowed, required, matches);
+}
+
+/* ************************************************************	*/
+/*					functions specific to this class			*/
+/* ************************************************************	*/
+
+// the nodes are visited in the order of their words: a node, then the
+//	nodes below each of its edges in turn, which is sorted order
+bool DawgDictionary::nextFinalNode(void) {
+
+	if (m_nodes.empty())
+		return false;
+
+	do {
+		if (!m_path_started) {
+			m_path_started = true;
+			continue;
+		}
+		uint32_t node = m_path_edges.empty() ? 0 : edgeTarget(m_edges[m_path_edges.back()]);
+		if (m_nodes[node].first_edge != m_nodes[node+1].first_edge) {
+			// down the first edge
+			m_path_edges.push_back(m_nodes[node].first_edge);
+			m_path += static_cast<char>(edgeLabel(m_edges[m_nodes[node].first_edge]));
+			continue;
+		}
+		// back up to the nearest edge with one after it, and take that
+		while (true) {
+			if (m_path_edges.empty())
+				return false;
+			uint32_t parent = m_path_edges.size() == 1 ? 0 :
+							  edgeTarget(m_edges[m_path_edges[m_path_edges.size() - 2]]);
+			uint32_t next_edge = m_path_edges.back() + 1;
+			if (next_edge != m_nodes[parent+1].first_edge) {
+				m_path_edges.back() = next_edge;
+				m_path.back() = static_cast<char>(edgeLabel(m_edges[next_edge]));
+				break;
+			}
+			m_path_edges.pop_back();
+			m_path.pop_back();
+		}
+	} while (!m_nodes[m_path_edges.empty() ? 0 : edgeTarget(m_edges[m_path_edges.back()])].isFinal());
+	return true;
+}
+
+// the words are added in sorted order, so each word only adds nodes
+//	below the prefix it shares with the word before it, and the nodes of
+//	the rest of the word before it will never change again.  Those are
+//	replaced by an equal node, one with the same edges to the same nodes,
+//	if one has been seen before, or else kept as the first of their kind
+bool DawgDictionary::build(Dictionary &dictionary) {
+
+	clear();
+
+	std::vector<std::string> words;
+	std::string_view batch[DefaultDictionaryBatchSize];
+	size_t num_words;
+	while ((num_words = dictionary.nextWords(batch)) != 0) {
+		// the same words that a LetterMaskIndex adds, so the ids agree
+		for (size_t i = 0; i != num_words; i++) {
+			if (!batch[i].empty() && batch[i].size() <= LetterMaskIndexMaxWordLength)
+				words.emplace_back(batch[i]);
+		}
+	}
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+	if (words.size() > std::numeric_limits<word_id_t>::max()) {
+		m_is_error = true;
+		return false;
+	}
+
+	struct BuildNode {
+		std::vector<std::pair<unsigned char, uint32_t>> edges;
+		bool is_final;
+		letter_mask_t suffix_letters;
+		uint32_t num_words;
+	};
+	std::vector<BuildNode> nodes(1, BuildNode{ {}, false, 0, 0 });
+	std::vector<uint32_t> free_nodes;
+	std::unordered_map<std::string, uint32_t> registered;
+	// path[i] is the node after the first i letters of the word before
+	std::vector<uint32_t> path(1, 0);
+	std::string signature;
+
+	// totals the words and letters after 'n', whose children are all final
+	auto finish = [&nodes](uint32_t n) {
+		BuildNode &node = nodes[n];
+		node.suffix_letters = 0;
+		node.num_words = node.is_final ? 1 : 0;
+		for (auto [label, child] : node.edges) {
+			node.suffix_letters |= letterBit(label) | nodes[child].suffix_letters;
+			node.num_words += nodes[child].num_words;
+		}
+	};
+
+	// the nodes past the first 'length' letters of the word before are final
+	auto minimize = [&](size_t length) {
+		while (path.size() > length + 1) {
+			uint32_t child = path.back();
+			path.pop_back();
+			finish(child);
+
+			signature.assign(1, nodes[child].is_final ? '1' : '0');
+			for (auto [label, target] : nodes[child].edges) {
+				signature += static_cast<char>(label);
+				signature.append(reinterpret_cast<const char *>(&target), sizeof(target));
+			}
+			auto [it, is_new] = registered.try_emplace(signature, child);
+			if (!is_new) {
+				nodes[path.back()].edges.back().second = it->second;
+				nodes[child].edges.clear();
+				nodes[child].is_final = false;
+				free_nodes.push_back(child);
+			}
+		}
+	};
+
+	std::string_view previous;
+	for (const std::string &word : words) {
+		size_t common = 0;
+		while (common != previous.size() && common != word.size() &&
+			   previous[common] == word[common]) {
+			common++;
+		}
+		minimize(common);
+		for (size_t i = common; i != word.size(); i++) {
+			uint32_t child;
+			if (free_nodes.empty()) {
+				child = nodes.size();
+				nodes.push_back(BuildNode{ {}, false, 0, 0 });
+			} else {
+				child = free_nodes.back();
+				free_nodes.pop_back();
+			}
+			nodes[path.back()].edges.emplace_back(static_cast<unsigned char>(word[i]), child);
+			path.push_back(child);
+		}
+		nodes[path.back()].is_final = true;
+		previous = word;
+	}
+	minimize(0);
+	finish(0);
+
+	// the nodes that are still used are numbered breadth first from the root
+	std::vector<uint32_t> number(nodes.size(), DawgDictionaryMaxNodes);
+	std::vector<uint32_t> order(1, 0);
+	number[0] = 0;
+	for (size_t i = 0; i != order.size(); i++) {
+		for (auto [label, child] : nodes[order[i]].edges) {
+			if (number[child] == DawgDictionaryMaxNodes) {
+				if (order.size() == DawgDictionaryMaxNodes) {
+					clear();
+					m_is_error = true;
+					return false;
+				}
+				number[child] = order.size();
+				order.push_back(child);
+			}
+		}
+	}
+
+	m_nodes.reserve(order.size() + 1);
+	for (uint32_t n : order) {
+		const BuildNode &node = nodes[n];
+		m_nodes.push_back({ static_cast<uint32_t>(m_edges.size()), node.num_words,
+							node.suffix_letters | (node.is_final ? DawgDictionaryFinal : 0) });
+		for (auto [label, child] : node.edges) {
+			m_edges.push_back((number[child] << DawgDictionaryLabelBits) | label);
+		}
+	}
+	m_nodes.push_back({ static_cast<uint32_t>(m_edges.size()), 0, 0 });
+	m_edges.shrink_to_fit();
+
+	return true;
+}
+
+void DawgDictionary::clear(void) {
+
+	m_nodes.clear();
+	m_edges.clear();
+	m_is_error = false;
+	begining();
+}
+
+size_t DawgDictionary::memoryUsed(void) const {
+
+	return m_nodes.size() * sizeof(Node) + m_edges.size() * sizeof(uint32_t);
+}
+
+// goes down the edge whose words hold the word numbered 'id',
+//	counting off the words passed over on the way
+std::string DawgDictionary::word(word_id_t id) const {
+
+	std::string word;
+	uint32_t node = 0;
+	while (true) {
+		if (m_nodes[node].isFinal()) {
+			if (id == 0)
+				return word;
+			id--;
+		}
+		for (uint32_t e = m_nodes[node].first_edge; e != m_nodes[node+1].first_edge; e++) {
+			uint32_t target = edgeTarget(m_edges[e]);
+			if (id < m_nodes[target].num_words) {
+				word += static_cast<char>(edgeLabel(m_edges[e]));
+				node = target;
+				break;
+			}
+			id -= m_nodes[target].num_words;
+		}
+	}
+}
+
+size_t DawgDictionary::find(std::string_view prefix, word_length_t min_length,
+							letter_mask_t allowed, letter_mask_t required,
+							std::vector<word_id_t> &matches) const {
+
+	if (m_nodes.empty() || (required & ~allowed) != 0)
+		return 0;
+
+	// the number of the first word after the prefix is the number of
+	//	words that come before it, on the way down and to the left
+	uint32_t node = 0;
+	word_id_t first_word = 0;
+	letter_mask_t missing = required;
+	for (char c : prefix) {
+		letter_mask_t bit = letterBit(c);
+		if ((bit & allowed) == 0)
+			return 0;
+		if (m_nodes[node].isFinal())
+			first_word++;
+		uint32_t e = m_nodes[node].first_edge;
+		uint32_t last_edge = m_nodes[node+1].first_edge;
+		while (e != last_edge && edgeLabel(m_edges[e]) < static_cast<unsigned char>(c)) {
+			first_word += m_nodes[edgeTarget(m_edges[e])].num_words;
+			e++;
+		}
+		if (e == last_edge || edgeLabel(m_edges[e]) != static_cast<unsigned char>(c))
+			return 0;
+		node = edgeTarget(m_edges[e]);
+		missing &= ~bit;
+	}
+
+	size_t first_match = matches.size();
+	Search query = { allowed, min_length, &matches };
+	search(query, node, prefix.size(), missing, first_word);
+	return matches.size() - first_match;
+}
+
+void DawgDictionary::search(const Search &query, uint32_t node, size_t length,
+							letter_mask_t missing, word_id_t first_word) const {
+
+	word_id_t word = first_word;
+	if (m_nodes[node].isFinal()) {
+		if (missing == 0 && length >= query.min_length)
+			query.matches->push_back(word);
+		word++;
+	}
+
+	for (uint32_t e = m_nodes[node].first_edge; e != m_nodes[node+1].first_edge; e++) {
+		uint32_t target = edgeTarget(m_edges[e]);
+		letter_mask_t bit = letterBit(static_cast<char>(edgeLabel(m_edges[e])));
+		letter_mask_t still_missing = missing & ~bit;
+		// a subtree is passed over if it has a letter that is not allowed
+		//	first, or if no word in it has the letters still missing
+		if ((bit & query.allowed) != 0 && (still_missing & ~m_nodes[target].suffixLetters()) == 0)
+			search(query, target, length + 1, still_missing, word);
+		word += m_nodes[target].num_words;
+	}
+}
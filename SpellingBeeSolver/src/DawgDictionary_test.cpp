@@ -0,0 +1,9 @@
+/*
+ * DawgDictionary_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "DawgDictionary.h"
+
@@ -14,3 +14,32 @@ Dictionary::Dictionary() {
 Dictionary::~Dictionary() {
 	// TODO Auto-generated destructor stub
 }
+
+// dictionaries that do not own their words lend out a copy,
+//	reusing the same buffer for every word
+bool Dictionary::nextWordView(std::string_view &word) {
+
+	if (!isNext())
+		return false;
+
+	m_word_buffer = nextWord();
+	word = m_word_buffer;
+	return true;
+}
+
+// each word needs its own buffer, since all the views must remain valid
+//	the buffers are reused from batch to batch
+size_t Dictionary::nextWords(std::span<std::string_view> words) {
+
+	if (m_batch_buffer.size() < words.size())
+		m_batch_buffer.resize(words.size());
+
+	size_t num_words = 0;
+	std::string_view word;
+	while (num_words != words.size() && nextWordView(word)) {
+		m_batch_buffer[num_words] = word;
+		words[num_words] = m_batch_buffer[num_words];
+		num_words++;
+	}
+	return num_words;
+}
@@ -9,9 +9,21 @@
 #define DICTIONARY_H_
 
 #include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// number of words a caller should ask nextWords() for at a time
+constexpr size_t DefaultDictionaryBatchSize = 256;
 
 class Dictionary {
+protected:
+	// holds the word lent out by the default nextWordView()
+	std::string m_word_buffer;
+	// holds the words lent out by the default nextWords()
+	std::vector<std::string> m_batch_buffer;
+
 public:
 	Dictionary();
 	virtual ~Dictionary();
@@ -20,6 +32,16 @@ public:
 	virtual bool	close(void) = 0;
 	virtual bool	begining(void) = 0;
 	virtual std::string nextWord(void) = 0;
+	// sets 'word' to the next word without copying it, where possible
+	//	the view is valid until the next call to any function that reads,
+	//	rewinds or closes the dictionary
+	//	returns false if there are no more words
+	virtual bool	nextWordView(std::string_view &word);
+	// fills 'words' with as many of the following words as are available
+	//	all of the views are valid until the next call to any function that
+	//	reads, rewinds or closes the dictionary
+	//	returns the number of words, which is 0 if there are no more words
+	virtual size_t	nextWords(std::span<std::string_view> words);
 	virtual	bool	isError(void) const = 0;
 	virtual	bool	isOpen(void) const = 0;
 	virtual bool	isNext(void) const = 0;
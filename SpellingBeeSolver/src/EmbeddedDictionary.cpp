@@ -0,0 +1,73 @@
+/*
+ * EmbeddedDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "EmbeddedDictionary.h"
+
+//	functions inherited from base class Dictionary
+bool EmbeddedDictionary::open(void) {
+
+	if (m_blob == nullptr || m_offsets == nullptr)
+		return false;
+
+	m_next_word = 0;
+	m_is_open = true;
+	return true;
+}
+
+bool EmbeddedDictionary::close(void) {
+
+	m_is_open = false;
+	return true;
+}
+
+bool EmbeddedDictionary::begining(void) {
+
+	m_next_word = 0;
+	return true;
+}
+
+std::string EmbeddedDictionary::nextWord(void) {
+
+	std::string_view view;
+	if (!nextWordView(view))
+		return std::string("");
+
+	return std::string(view);
+}
+
+bool EmbeddedDictionary::nextWordView(std::string_view &view) {
+
+	if (!m_is_open || m_next_word >= m_num_words)
+		return false;
+
+	view = word(m_next_word++);
+	return true;
+}
+
+size_t EmbeddedDictionary::nextWords(std::span<std::string_view> words) {
+
+	size_t num_words = 0;
+	if (!m_is_open)
+		return num_words;
+
+	while (num_words != words.size() && m_next_word < m_num_words) {
+		words[num_words++] = word(m_next_word++);
+	}
+	return num_words;
+}
+
+bool EmbeddedDictionary::isError(void) const {
+	return m_blob == nullptr || m_offsets == nullptr;
+}
+
+bool EmbeddedDictionary::isOpen(void) const {
+	return m_is_open;
+}
+
+bool EmbeddedDictionary::isNext(void) const {
+	return m_next_word < m_num_words;
+}
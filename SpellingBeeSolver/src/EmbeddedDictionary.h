@@ -0,0 +1,155 @@
+/*
+ * EmbeddedDictionary.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef EMBEDDEDDICTIONARY_H_
+#define EMBEDDEDDICTIONARY_H_
+
+#include "Dictionary.h"
+
+#include <array>
+#include <cstdint>
+
+#include "LetterMask.h"
+#include "SpellingBeeSolver.h"
+
+/*	An embedded dictionary is a single constant character array (a 'blob')
+ *	holding every word followed by '\n', plus a table of the offset of
+ *	each word in the blob.  Both are built by the compiler, so the
+ *	dictionary costs nothing at static initialization and lives in
+ *	read-only pages that are shared by every running copy of the program
+ *
+ *	The table has one more entry than there are words, the last entry
+ *	being the size of the blob, so word i is
+ *		[offsets[i], offsets[i+1] - 1)
+ *
+ *	The length and letter mask of every word can also be computed by the
+ *	compiler, so that a LetterMaskIndex of the blob needs no building
+ *
+ *	Computing them for the default dictionary of 70K words and 945KB
+ *	is a large constant evaluation, which compilers limit.  With GCC,
+ *	which this project builds with, the defaults are enough: the largest
+ *	table takes between 2^24 and 2^25 operations, against
+ *	-fconstexpr-ops-limit of 2^33, and each loop runs once per word,
+ *	against -fconstexpr-loop-limit of 262144, so a dictionary of more
+ *	words than that needs the limit raised.  Clang stops at
+ *	-fconstexpr-steps of 2^20 and MSVC at /constexpr:steps of 100000,
+ *	so either needs that raised well past the GCC count, or the program
+ *	built with -DCOMPILE_DEFAULT_DICTIONARY=0 and the dictionary given
+ *	with -f, perhaps compiled with --compile-dict
+ */
+
+// the number of words in 'blob', which must end in '\n'
+//	each word is one iteration of the outer loop, which keeps the
+//	iteration count well below the compiler's constexpr loop limit
+template<size_t N>
+constexpr dictionary_size_t embeddedWordCount(const char (&blob)[N]) {
+	dictionary_size_t num_words = 0;
+	size_t i = 0;
+	while (i < N-1) {
+		while (blob[i] != '\n')
+			i++;
+		i++;
+		num_words++;
+	}
+	return num_words;
+}
+
+template<dictionary_size_t NumWords, size_t N>
+constexpr std::array<uint32_t, NumWords+1> embeddedWordOffsets(const char (&blob)[N]) {
+	std::array<uint32_t, NumWords+1> offsets{};
+	size_t i = 0;
+	for (dictionary_size_t word = 0; word != NumWords; word++) {
+		offsets[word] = static_cast<uint32_t>(i);
+		while (blob[i] != '\n')
+			i++;
+		i++;
+	}
+	offsets[NumWords] = static_cast<uint32_t>(i);
+	return offsets;
+}
+
+template<dictionary_size_t NumWords, size_t N>
+constexpr std::array<word_length_t, NumWords> embeddedWordLengths(const char (&blob)[N]) {
+	std::array<word_length_t, NumWords> lengths{};
+	size_t i = 0;
+	for (dictionary_size_t word = 0; word != NumWords; word++) {
+		size_t start = i;
+		while (blob[i] != '\n')
+			i++;
+		lengths[word] = static_cast<word_length_t>(i - start);
+		i++;
+	}
+	return lengths;
+}
+
+template<dictionary_size_t NumWords, size_t N>
+constexpr std::array<letter_mask_t, NumWords> embeddedWordMasks(const char (&blob)[N]) {
+	std::array<letter_mask_t, NumWords> masks{};
+	size_t i = 0;
+	for (dictionary_size_t word = 0; word != NumWords; word++) {
+		letter_mask_t mask = 0;
+		while (blob[i] != '\n')
+			mask |= letterBit(blob[i++]);
+		masks[word] = mask;
+		i++;
+	}
+	return masks;
+}
+
+class EmbeddedDictionary: public Dictionary {
+private:
+	const char *m_blob;
+	const uint32_t *m_offsets;
+	dictionary_size_t m_num_words;
+	dictionary_size_t m_next_word;
+	bool m_is_open;
+
+public:
+	EmbeddedDictionary() :
+		m_blob(nullptr),
+		m_offsets(nullptr),
+		m_num_words(0),
+		m_next_word(0),
+		m_is_open(false) {}
+
+	// 'offsets' must have num_words+1 entries
+	EmbeddedDictionary(const char *blob, const uint32_t *offsets, dictionary_size_t num_words) :
+		m_blob(blob),
+		m_offsets(offsets),
+		m_num_words(num_words),
+		m_next_word(0),
+		m_is_open(false) {}
+
+	virtual ~EmbeddedDictionary() {}
+
+	// the blob and table are never owned, so copies are harmless
+	EmbeddedDictionary(const EmbeddedDictionary &other) = default;
+	EmbeddedDictionary& operator=(const EmbeddedDictionary &other) = default;
+
+	/*	**********************************************	*/
+	/*	functions inherited from base class Dictionary  */
+	/* 	**********************************************	*/
+
+	bool open(void);
+	bool close(void);
+	bool begining(void);
+	std::string nextWord(void);
+	// the view is into the blob, and is always valid
+	bool nextWordView(std::string_view &word);
+	size_t nextWords(std::span<std::string_view> words);
+	bool isError(void) const;
+	bool isOpen(void) const;
+	bool isNext(void) const;
+
+	//	functions specific to this class
+	dictionary_size_t size(void) const	{ return m_num_words; }
+	std::string_view word(dictionary_size_t i) const {
+		return std::string_view(m_blob + m_offsets[i], m_offsets[i+1] - m_offsets[i] - 1);
+	}
+};
+
+#endif /* EMBEDDEDDICTIONARY_H_ */
@@ -15,7 +15,10 @@ FileDictionary::FileDictionary() :
 	m_fileopen(false),
 	m_file_state(FileDictionaryState::FILE_NOT_OPEN),
 	m_error(false),
-	m_linesize(DefaultFileDictionaryLineSize) {}
+	m_at_beginning(false),
+	m_linesize(DefaultFileDictionaryLineSize) {
+	m_line.reserve(m_linesize);
+}
 
 FileDictionary::~FileDictionary() {
 
@@ -63,8 +66,13 @@ FileDictionary::FileDictionary(FileDictionary &&other) {
 	m_error = other.m_error;
 	other.m_error = false;
 
+	m_at_beginning = other.m_at_beginning;
+	other.m_at_beginning = false;
+
 	m_linesize = DefaultFileDictionaryLineSize;
 	other.m_linesize = DefaultFileDictionaryLineSize;
+
+	m_line = std::move(other.m_line);
 }
 
 FileDictionary& FileDictionary::operator=(FileDictionary &&other) {
@@ -94,9 +102,14 @@ FileDictionary& FileDictionary::operator=(FileDictionary &&other) {
 	m_error = other.m_error;
 	other.m_error = false;
 
+	m_at_beginning = other.m_at_beginning;
+	other.m_at_beginning = false;
+
 	m_linesize = DefaultFileDictionaryLineSize;
 	other.m_linesize = DefaultFileDictionaryLineSize;
 
+	m_line = std::move(other.m_line);
+
 	return *this;
 }
 
@@ -108,6 +121,7 @@ FileDictionary::FileDictionary(const std::string filename) {
 	m_fileopen_attempted = true;
 	m_file = new std::ifstream(filename);
 
+	m_at_beginning = true;
 	if (m_file->good()) {
 		m_fileopen = true;
 		m_error = false;
@@ -119,6 +133,7 @@ FileDictionary::FileDictionary(const std::string filename) {
 	}
 
 	m_linesize = DefaultFileDictionaryLineSize;
+	m_line.reserve(m_linesize);
 }
 
 
@@ -146,6 +161,7 @@ bool FileDictionary::open(void) {
 
 	m_file = new std::ifstream(*m_filename);
 
+	m_at_beginning = true;
 	if (m_file->is_open()) {
 		m_fileopen = true;
 		m_file_state = FileDictionaryState::FILE_OPEN;
@@ -192,12 +208,18 @@ bool FileDictionary::begining() {
 		return result;
 	}
 
+	if (m_at_beginning) {
+		return true;
+	}
+
 	// Move back to the beginning of the file
 	m_file->clear(); // Clear any error flags (e.g., eofbit if at end of file)
 	m_file->seekg(0, std::ios::beg); // Set the read pointer to the beginning
-	if (!m_file->bad()) {
+	// a pipe cannot seek, so it cannot be read again once it has been read
+	if (!m_file->fail()) {
 		m_error = false;
 		m_file_state = FileDictionaryState::FILE_OPEN;
+		m_at_beginning = true;
 		result = true;
 	} else {
 		m_error = true;
@@ -246,23 +268,62 @@ bool FileDictionary::isNext(void) const {
 
 std::string FileDictionary::nextWord() {
 
-	std::string result("");
+	std::string_view word;
+	if (!nextWordView(word))
+		return std::string("");
+
+	return std::string(word);
+}
+
+bool FileDictionary::nextWordView(std::string_view &word) {
+
+	if (!readLine(m_line))
+		return false;
+
+	word = m_line;
+	return true;
+}
+
+// each line is read directly into its own buffer in m_batch_buffer
+size_t FileDictionary::nextWords(std::span<std::string_view> words) {
+
+	if (m_batch_buffer.size() < words.size())
+		m_batch_buffer.resize(words.size());
+
+	size_t num_words = 0;
+	while (num_words != words.size() && readLine(m_batch_buffer[num_words])) {
+		words[num_words] = m_batch_buffer[num_words];
+		num_words++;
+	}
+	return num_words;
+}
+
+bool FileDictionary::readLine(std::string &line) {
+
 	if (m_file == nullptr || !isNext() || isError() || !isOpen())
-		return result;
+		return false;
 
 	if (m_file->eof()) {
 		m_file_state = FileDictionaryState::READ_PAST_END;
 		m_error = true;
-		return result;
+		return false;
 	}
 
-	char *line = new char[m_linesize+1];
-	m_file->getline(line, m_linesize);
+	// std::getline reuses the capacity of 'line',
+	//	so once it has grown to the longest word no memory is allocated
+	std::getline(*m_file, line);
+	m_at_beginning = false;
 
-	result = line;
-	delete[] line;
-	line = nullptr;
-	return result;
+	if (m_file->fail()) {
+		// reading past the last '\n' is not an error, there are no more words
+		if (m_file->eof())
+			return false;
+		m_file_state = FileDictionaryState::FILE_READ_ERROR;
+		m_error = true;
+		return false;
+	}
+
+	return true;
 }
 
 std::string	FileDictionary::filename(void) const {
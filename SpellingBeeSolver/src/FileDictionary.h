@@ -51,10 +51,17 @@ private:
 	FileDictionaryState m_file_state;
 	// this is the OR of all the things that could go wrong
 	bool m_error;
-	// limit the number of chars read
+	// no line has been read since the file was opened or rewound,
+	//	so begining() need not seek, which a pipe cannot do
+	bool m_at_beginning;
+	// initial capacity of m_line
 	int m_linesize;
+	// the last line read, reused for every line
+	std::string m_line;
 
 	FileDictionary();
+	// reads the next line into 'line', returns false if there is none
+	bool readLine(std::string &line);
 
 public:
 	// Rule of Five
@@ -85,6 +92,9 @@ public:
 	bool close(void);
 	bool begining(void);
 	std::string nextWord(void);
+	// the view is valid until the next line is read
+	bool nextWordView(std::string_view &word);
+	size_t nextWords(std::span<std::string_view> words);
 	bool isOpen(void) const;
 	bool isNext(void) const;
 	bool isError(void) const;
@@ -0,0 +1,18 @@
+/*
+ * Hash.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "Hash.h"
+
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash) {
+
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	for (size_t i = 0; i != size; i++) {
+		hash ^= bytes[i];
+		hash *= Fnv1aPrime;
+	}
+	return hash;
+}
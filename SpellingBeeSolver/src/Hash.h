@@ -0,0 +1,21 @@
+/*
+ * Hash.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint64_t Fnv1aOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t Fnv1aPrime = 0x100000001b3ULL;
+
+// 64 bit FNV-1a hash of 'size' bytes, which may be continued
+//	by passing the previous result as 'hash'
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash = Fnv1aOffsetBasis);
+
+#endif /* HASH_H_ */
@@ -0,0 +1,520 @@
+/*
+ * HttpServer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "HttpServer.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "LetterMask.h"
+#include "Puzzle.h"
+
+static std::string_view trim(std::string_view text) {
+
+	while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+		text.remove_prefix(1);
+	while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+		text.remove_suffix(1);
+	return text;
+}
+
+static bool equalsIgnoringCase(std::string_view a, std::string_view b) {
+	return a.size() == b.size() && strncasecmp(a.data(), b.data(), a.size()) == 0;
+}
+
+static int hexDigit(char c) {
+
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c |= 0x20;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+// decodes %XX escapes and '+' in a query string parameter
+static std::string decodeParameter(std::string_view text) {
+
+	std::string decoded;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '+') {
+			decoded += ' ';
+		} else if (text[i] == '%' && i+2 < text.size() &&
+				   hexDigit(text[i+1]) >= 0 && hexDigit(text[i+2]) >= 0) {
+			decoded += static_cast<char>(hexDigit(text[i+1]) * 16 + hexDigit(text[i+2]));
+			i += 2;
+		} else {
+			decoded += text[i];
+		}
+	}
+	return decoded;
+}
+
+static void appendJsonString(std::string &json, std::string_view text) {
+
+	json += '"';
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			json += '\\';
+			json += c;
+		} else if (static_cast<unsigned char>(c) < 0x20 ||
+				   static_cast<unsigned char>(c) >= 0x80) {
+			char escape[8];
+			snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+			json += escape;
+		} else {
+			json += c;
+		}
+	}
+	json += '"';
+}
+
+HttpServer::HttpServer(Solver &solver, int min_letters, int max_letters, bool nyt_rules) :
+	m_solver(solver),
+	m_min_letters(min_letters),
+	m_max_letters(max_letters),
+	m_nyt_rules(nyt_rules),
+	m_listen_fd(-1),
+	m_epoll_fd(-1),
+	m_reserve_fd(-1) {}
+
+HttpServer::~HttpServer() {
+
+	for (auto &entry : m_connections) {
+		::close(entry.first);
+	}
+	if (m_epoll_fd >= 0)
+		::close(m_epoll_fd);
+	if (m_listen_fd >= 0)
+		::close(m_listen_fd);
+	if (m_reserve_fd >= 0)
+		::close(m_reserve_fd);
+}
+
+bool HttpServer::listen(const std::string &address) {
+
+	// an address that cannot be parsed is reported like any other bad argument
+	errno = EINVAL;
+	size_t colon = address.rfind(':');
+	if (colon == std::string::npos)
+		return false;
+
+	struct sockaddr_in socket_address;
+	memset(&socket_address, 0, sizeof(socket_address));
+	socket_address.sin_family = AF_INET;
+	std::string host = address.substr(0, colon);
+	if (inet_pton(AF_INET, host.c_str(), &socket_address.sin_addr) != 1)
+		return false;
+	char *end;
+	unsigned long port = strtoul(address.c_str() + colon + 1, &end, 10);
+	if (end == address.c_str() + colon + 1 || *end != '\0' || port > 65535)
+		return false;
+	socket_address.sin_port = htons(static_cast<uint16_t>(port));
+
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return false;
+	int on = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	if (bind(fd, reinterpret_cast<struct sockaddr *>(&socket_address),
+			 sizeof(socket_address)) != 0 ||
+		::listen(fd, HttpServerBacklog) != 0) {
+		::close(fd);
+		return false;
+	}
+
+	int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = fd;
+	if (epoll_fd < 0 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+		if (epoll_fd >= 0)
+			::close(epoll_fd);
+		::close(fd);
+		return false;
+	}
+
+	m_listen_fd = fd;
+	m_epoll_fd = epoll_fd;
+	m_reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+	m_last_idle_check = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool HttpServer::serve(void) {
+
+	if (m_epoll_fd < 0)
+		return false;
+
+	struct epoll_event events[HttpServerMaxEvents];
+	for (;;) {
+		int num_events = epoll_wait(m_epoll_fd, events, HttpServerMaxEvents,
+									 HttpServerIdleCheckMilliseconds);
+		if (num_events < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		for (int i = 0; i != num_events; i++) {
+			int fd = events[i].data.fd;
+			if (fd == m_listen_fd) {
+				acceptConnections();
+				continue;
+			}
+
+			auto entry = m_connections.find(fd);
+			if (entry == m_connections.end())
+				continue;
+			Connection &connection = entry->second;
+
+			bool keep = (events[i].events & EPOLLERR) == 0;
+			if (keep && (events[i].events & (EPOLLIN | EPOLLHUP)))
+				keep = receive(fd, connection);
+			// responses are sent as soon as they are queued, and
+			//	the rest when the socket becomes writable
+			if (keep && connection.pendingOutput() != 0)
+				keep = send(fd, connection);
+			// requests left unanswered while too much output was pending
+			//	are answered once enough of it has been sent, until the
+			//	socket is full or only an incomplete request is left
+			while (keep && !connection.input.empty() && !connection.close_after_output &&
+				   connection.pendingOutput() <= HttpServerMaxPendingOutput) {
+				size_t unanswered = connection.input.size();
+				handleRequests(connection);
+				keep = send(fd, connection);
+				if (connection.input.size() == unanswered)
+					break;
+			}
+			if (!keep) {
+				closeConnection(fd);
+				continue;
+			}
+			updateEvents(fd, connection);
+		}
+		// after the events, which may refer to the connections it closes
+		closeIdleConnections();
+	}
+}
+
+void HttpServer::acceptConnections(void) {
+
+	for (;;) {
+		int fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0 && (errno == EINTR || errno == ECONNABORTED))
+			continue;
+		// without a descriptor to accept it with, the connection would
+		//	stay waiting and epoll would report it again at once
+		if (fd < 0 && (errno == EMFILE || errno == ENFILE) && m_reserve_fd >= 0) {
+			::close(m_reserve_fd);
+			fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (fd >= 0)
+				::close(fd);
+			m_reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+				return;
+			continue;
+		}
+		if (fd < 0)
+			return;
+
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+			::close(fd);
+			continue;
+		}
+		m_connections[fd] = Connection{ "", "", 0, false, EPOLLIN,
+										std::chrono::steady_clock::now() };
+	}
+}
+
+void HttpServer::closeConnection(int fd) {
+
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+	::close(fd);
+	m_connections.erase(fd);
+}
+
+void HttpServer::closeIdleConnections(void) {
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - m_last_idle_check < std::chrono::milliseconds(HttpServerIdleCheckMilliseconds))
+		return;
+	m_last_idle_check = now;
+
+	std::vector<int> idle;
+	for (auto &entry : m_connections) {
+		if (now - entry.second.last_active >= std::chrono::seconds(HttpServerIdleTimeoutSeconds))
+			idle.push_back(entry.first);
+	}
+	for (int fd : idle)
+		closeConnection(fd);
+}
+
+bool HttpServer::receive(int fd, Connection &connection) {
+
+	char buffer[HttpServerReceiveSize];
+	bool finished_sending = false;
+	// the rest is read once the client has read enough of the responses
+	while (connection.pendingOutput() <= HttpServerMaxPendingOutput) {
+		ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+		if (received > 0) {
+			connection.last_active = std::chrono::steady_clock::now();
+			// nothing more is read from a connection that is closing
+			if (!connection.close_after_output) {
+				connection.input.append(buffer, received);
+				handleRequests(connection);
+			}
+			continue;
+		}
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		if (received < 0)
+			return false;
+
+		finished_sending = true;
+		break;
+	}
+
+	// every complete request that arrived before the client finished
+	//	sending has been answered, since it is only read while there is
+	//	room for the responses
+	if (finished_sending)
+		connection.close_after_output = true;
+	return !connection.close_after_output || connection.pendingOutput() != 0;
+}
+
+bool HttpServer::send(int fd, Connection &connection) {
+
+	while (connection.pendingOutput() != 0) {
+		ssize_t sent = ::send(fd, connection.output.data() + connection.output_sent,
+							  connection.output.size() - connection.output_sent,
+							  MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return true;
+		if (sent < 0)
+			return false;
+		connection.output_sent += sent;
+		connection.last_active = std::chrono::steady_clock::now();
+	}
+
+	connection.output.clear();
+	connection.output_sent = 0;
+	return !connection.close_after_output;
+}
+
+void HttpServer::updateEvents(int fd, Connection &connection) {
+
+	uint32_t events = 0;
+	if (connection.pendingOutput() <= HttpServerMaxPendingOutput)
+		events |= EPOLLIN;
+	if (connection.pendingOutput() != 0)
+		events |= EPOLLOUT;
+	if (events != connection.events) {
+		struct epoll_event event;
+		event.events = events;
+		event.data.fd = fd;
+		epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &event);
+		connection.events = events;
+	}
+}
+
+void HttpServer::handleRequests(Connection &connection) {
+
+	size_t consumed = 0;
+	while (consumed != connection.input.size() &&
+		   connection.pendingOutput() <= HttpServerMaxPendingOutput) {
+		std::string_view input(connection.input);
+		input.remove_prefix(consumed);
+		size_t end_of_head = input.find("\r\n\r\n");
+		if (end_of_head == std::string_view::npos) {
+			if (input.size() > HttpServerMaxRequestSize) {
+				queueResponse(connection, 431, "Request Header Fields Too Large",
+							  "{\"error\":\"request too large\"}", false);
+			}
+			break;
+		}
+		std::string_view head = input.substr(0, end_of_head);
+		consumed += end_of_head + 4;
+
+		// request line, "GET /solve?letters=abcdefg HTTP/1.1"
+		size_t end_of_line = head.find("\r\n");
+		std::string_view request_line = head.substr(0, end_of_line);
+		std::string_view headers = end_of_line == std::string_view::npos ?
+				std::string_view() : head.substr(end_of_line + 2);
+		size_t first_space = request_line.find(' ');
+		size_t last_space = request_line.rfind(' ');
+		if (first_space == std::string_view::npos || first_space == last_space) {
+			queueResponse(connection, 400, "Bad Request",
+						  "{\"error\":\"malformed request\"}", false);
+			break;
+		}
+		std::string_view method = request_line.substr(0, first_space);
+		std::string_view target = request_line.substr(first_space + 1, last_space - first_space - 1);
+		std::string_view version = request_line.substr(last_space + 1);
+
+		// HTTP/1.1 connections stay open unless the client says otherwise
+		bool keep_alive = version == "HTTP/1.1";
+		bool has_body = false;
+		while (!headers.empty()) {
+			size_t end = headers.find("\r\n");
+			std::string_view line = headers.substr(0, end);
+			headers = end == std::string_view::npos ? std::string_view() : headers.substr(end + 2);
+
+			size_t colon = line.find(':');
+			if (colon == std::string_view::npos)
+				continue;
+			std::string_view name = trim(line.substr(0, colon));
+			std::string_view value = trim(line.substr(colon + 1));
+			if (equalsIgnoringCase(name, "Connection")) {
+				if (equalsIgnoringCase(value, "close"))
+					keep_alive = false;
+				else if (equalsIgnoringCase(value, "keep-alive"))
+					keep_alive = true;
+			} else if (equalsIgnoringCase(name, "Transfer-Encoding") ||
+					   (equalsIgnoringCase(name, "Content-Length") && value != "0")) {
+				has_body = true;
+			}
+		}
+
+		// the end of a body cannot be found without reading it
+		if (has_body) {
+			queueResponse(connection, 400, "Bad Request",
+						  "{\"error\":\"requests with a body are not supported\"}", false);
+			break;
+		}
+
+		handleRequest(connection, method, target, keep_alive);
+		if (connection.close_after_output)
+			break;
+	}
+
+	connection.input.erase(0, consumed);
+	if (connection.close_after_output)
+		connection.input.clear();
+}
+
+void HttpServer::handleRequest(Connection &connection, std::string_view method,
+							   std::string_view target, bool keep_alive) {
+
+	size_t question_mark = target.find('?');
+	std::string_view path = target.substr(0, question_mark);
+	std::string_view query = question_mark == std::string_view::npos ?
+			std::string_view() : target.substr(question_mark + 1);
+
+	if (path != "/solve") {
+		queueResponse(connection, 404, "Not Found",
+					  "{\"error\":\"not found\"}", keep_alive);
+	} else if (method != "GET") {
+		queueResponse(connection, 405, "Method Not Allowed",
+					  "{\"error\":\"only GET is supported\"}", keep_alive);
+	} else {
+		solve(connection, query, keep_alive);
+	}
+}
+
+void HttpServer::solve(Connection &connection, std::string_view query, bool keep_alive) {
+
+	std::string letters;
+	std::string center;
+	bool has_center = false;
+	while (!query.empty()) {
+		size_t ampersand = query.find('&');
+		std::string_view parameter = query.substr(0, ampersand);
+		query = ampersand == std::string_view::npos ?
+				std::string_view() : query.substr(ampersand + 1);
+
+		size_t equals = parameter.find('=');
+		std::string_view name = parameter.substr(0, equals);
+		std::string_view value = equals == std::string_view::npos ?
+				std::string_view() : parameter.substr(equals + 1);
+		if (name == "letters") {
+			letters = decodeParameter(value);
+		} else if (name == "center") {
+			center = decodeParameter(value);
+			has_center = true;
+		}
+	}
+
+	Puzzle puzzle = makePuzzle(letters);
+	if (has_center) {
+		if (center.size() != 1 || letterBit(center[0]) == LetterMaskInvalid) {
+			queueResponse(connection, 400, "Bad Request",
+						  "{\"error\":\"center must be a single letter\"}", keep_alive);
+			return;
+		}
+		//	the same rules as a center letter given to the console
+		if (!applyNytRules(puzzle, center[0])) {
+			queueResponse(connection, 400, "Bad Request",
+						  "{\"error\":\"center must be one of the letters\"}", keep_alive);
+			return;
+		}
+	} else if (m_nyt_rules) {
+		applyNytRules(puzzle, PuzzleNoCenter);
+	}
+
+	int num_letters = numberOfLetters(puzzle.allowed);
+	if ((puzzle.allowed & LetterMaskInvalid) ||
+		num_letters < m_min_letters || num_letters > m_max_letters) {
+		char error[128];
+		snprintf(error, sizeof(error),
+				 "{\"error\":\"letters must be between %d and %d distinct letters\"}",
+				 m_min_letters, m_max_letters);
+		queueResponse(connection, 400, "Bad Request", error, keep_alive);
+		return;
+	}
+
+	m_matches.clear();
+	m_solver.find(puzzle, m_matches);
+
+	std::string body;
+	body += '[';
+	for (size_t i = 0; i != m_matches.size(); i++) {
+		if (i != 0)
+			body += ',';
+		appendJsonString(body, m_solver.word(m_matches[i]));
+	}
+	body += ']';
+	queueResponse(connection, 200, "OK", body, keep_alive);
+}
+
+void HttpServer::queueResponse(Connection &connection, int status, std::string_view reason,
+							   std::string_view body, bool keep_alive) {
+
+	char head[256];
+	int head_size = snprintf(head, sizeof(head),
+							 "HTTP/1.1 %d %.*s\r\n"
+							 "Content-Type: application/json\r\n"
+							 "Content-Length: %zu\r\n"
+							 "Connection: %s\r\n"
+							 "%s"
+							 "\r\n",
+							 status, static_cast<int>(reason.size()), reason.data(),
+							 body.size(),
+							 keep_alive ? "keep-alive" : "close",
+							 status == 405 ? "Allow: GET\r\n" : "");
+	connection.output.append(head, head_size);
+	connection.output.append(body);
+	if (!keep_alive)
+		connection.close_after_output = true;
+}
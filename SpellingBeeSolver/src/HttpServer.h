@@ -0,0 +1,125 @@
+/*
+ * HttpServer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef HTTPSERVER_H_
+#define HTTPSERVER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Solver.h"
+
+/*	Answers searches over HTTP/1.1 on a TCP address
+ *
+ *		GET /solve?letters=abcdefg				words that use all of the
+ *												letters and only those letters
+ *		GET /solve?letters=abcdefg&center=a		words that only use the letters,
+ *												use the center letter, which must
+ *												be one of them, and are at least
+ *												PuzzleNytMinWordLength long
+ *	When the server follows the NYT rules, a search without a center letter
+ *	uses the first of its letters, as the console does
+ *
+ *	The response is a JSON array of the words in dictionary order.  A bad
+ *	search is answered with 400 and a JSON object holding an "error"
+ *	The dictionary's bytes are not assumed to be UTF-8, so every byte
+ *	of 0x80 and above is escaped as the \u00XX of its Latin-1 character
+ *
+ *	Every connection is handled by a single thread waiting on epoll, with
+ *	non-blocking sockets, so connections are cheap and are kept open
+ *	between requests unless the client asks for them to be closed.
+ *	Requests with a body are not supported.  A connection whose client
+ *	is not reading its responses stops being read, and its requests stop
+ *	being answered, once more than HttpServerMaxPendingOutput bytes of
+ *	responses are waiting to be sent, so neither of its buffers can grow
+ *	without a bound
+ *
+ *	A connection that neither sends nor reads anything for
+ *	HttpServerIdleTimeoutSeconds is closed.  When the process runs out
+ *	of descriptors, a descriptor kept in reserve is given up to accept
+ *	each waiting connection and close it at once, so that it is not left
+ *	waiting with the listening socket always ready
+ */
+
+// a request whose headers do not fit in this is refused
+constexpr size_t HttpServerMaxRequestSize = 8192;
+constexpr size_t HttpServerReceiveSize = 16384;
+constexpr size_t HttpServerMaxPendingOutput = 262144;
+constexpr int HttpServerMaxEvents = 64;
+constexpr int HttpServerBacklog = 1024;
+constexpr int HttpServerIdleTimeoutSeconds = 30;
+// how often idle connections are looked for
+constexpr int HttpServerIdleCheckMilliseconds = 1000;
+
+class HttpServer {
+private:
+	struct Connection {
+		std::string input;
+		std::string output;
+		size_t output_sent;
+		// set once the response to the last request has been queued
+		bool close_after_output;
+		// the events epoll is waiting for on the socket: EPOLLIN unless
+		//	too much output is pending, EPOLLOUT while any is
+		uint32_t events;
+		// when anything was last received or sent
+		std::chrono::steady_clock::time_point last_active;
+
+		size_t pendingOutput(void) const	{ return output.size() - output_sent; }
+	};
+
+	Solver &m_solver;
+	int m_min_letters;
+	int m_max_letters;
+	bool m_nyt_rules;
+	int m_listen_fd;
+	int m_epoll_fd;
+	// an open descriptor that is closed to make room for accepting a
+	//	connection, only to close it, when none are left
+	int m_reserve_fd;
+	std::chrono::steady_clock::time_point m_last_idle_check;
+	std::unordered_map<int, Connection> m_connections;
+	std::vector<word_id_t> m_matches;
+
+	HttpServer();
+	void acceptConnections(void);
+	void closeConnection(int fd);
+	// closes the connections that have been idle for too long
+	void closeIdleConnections(void);
+	// each returns false once the connection should be closed
+	bool receive(int fd, Connection &connection);
+	bool send(int fd, Connection &connection);
+	// asks epoll for the events the connection is now waiting for
+	void updateEvents(int fd, Connection &connection);
+	// answers every complete request in the connection's input
+	void handleRequests(Connection &connection);
+	void handleRequest(Connection &connection, std::string_view method,
+					   std::string_view target, bool keep_alive);
+	void solve(Connection &connection, std::string_view query, bool keep_alive);
+	void queueResponse(Connection &connection, int status, std::string_view reason,
+					   std::string_view body, bool keep_alive);
+
+public:
+	HttpServer(Solver &solver, int min_letters, int max_letters, bool nyt_rules);
+	virtual ~HttpServer();
+
+	HttpServer(const HttpServer &other) = delete;
+	HttpServer& operator=(const HttpServer &other) = delete;
+
+	// listens on 'address', an IPv4 address and a port such as
+	//	"127.0.0.1:8080".  Returns false if it is not valid or cannot be used
+	bool listen(const std::string &address);
+	// answers requests until waiting for them fails, only returns on error
+	bool serve(void);
+};
+
+#endif /* HTTPSERVER_H_ */
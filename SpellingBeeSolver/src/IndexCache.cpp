@@ -0,0 +1,113 @@
+/*
+ * IndexCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "IndexCache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+#include "Hash.h"
+
+IndexCache::IndexCache() :
+	m_dictionary_filename(""),
+	m_cache_filename(""),
+	m_source{},
+	m_source_described(false),
+	m_source_hashed(false) {}
+
+IndexCache::~IndexCache() {}
+
+IndexCache::IndexCache(const std::string &dictionary_filename) :
+	m_dictionary_filename(dictionary_filename),
+	m_cache_filename(""),
+	m_source{},
+	m_source_described(false),
+	m_source_hashed(false) {
+
+	std::error_code error;
+	std::filesystem::path path = std::filesystem::absolute(dictionary_filename, error);
+	if (error)
+		path = dictionary_filename;
+
+	std::string directory = cacheDirectory();
+	if (directory.empty()) {
+		m_cache_filename = path.string() + CompiledDictionaryExtension;
+		return;
+	}
+
+	// the file name is kept so that the cache can be read by people,
+	//	the hash of the path tells dictionaries of the same name apart
+	std::string key = path.string();
+	char hash[17];
+	snprintf(hash, sizeof(hash), "%016llx",
+			 static_cast<unsigned long long>(fnv1a(key.data(), key.size())));
+	m_cache_filename = (std::filesystem::path(directory) /
+						(path.filename().string() + "-" + hash + CompiledDictionaryExtension)).string();
+}
+
+std::unique_ptr<CompiledDictionary> IndexCache::load(void) {
+
+	m_source_described = CompiledDictionary::statSource(m_dictionary_filename, m_source);
+	m_source_hashed = false;
+	if (!m_source_described)
+		return nullptr;
+
+	if (!CompiledDictionary::isCompiledDictionary(m_cache_filename))
+		return nullptr;
+
+	std::unique_ptr<CompiledDictionary> cached =
+			std::make_unique<CompiledDictionary>(m_cache_filename);
+	if (cached->isError())
+		return nullptr;
+
+	// the text is only read if it looks unchanged
+	const CompiledDictionarySource &source = cached->source();
+	if (source.size != m_source.size || source.mtime != m_source.mtime)
+		return nullptr;
+	m_source_hashed = CompiledDictionary::hashSource(m_dictionary_filename, m_source);
+	if (!m_source_hashed || source.hash != m_source.hash)
+		return nullptr;
+
+	return cached;
+}
+
+bool IndexCache::save(const LetterMaskIndex &index) {
+
+	if (!m_source_described)
+		return false;
+	if (!m_source_hashed)
+		m_source_hashed = CompiledDictionary::hashSource(m_dictionary_filename, m_source);
+	if (!m_source_hashed)
+		return false;
+
+	return CompiledDictionary::write(index, m_source, m_cache_filename);
+}
+
+std::string IndexCache::cacheDirectory(void) {
+
+	std::filesystem::path directory;
+	const char *xdg_cache_home = getenv("XDG_CACHE_HOME");
+	const char *home = getenv("HOME");
+	// the XDG specification says a relative path is to be ignored
+	if (xdg_cache_home && xdg_cache_home[0] == '/') {
+		directory = xdg_cache_home;
+	} else if (home && home[0] != '\0') {
+		directory = std::filesystem::path(home) / ".cache";
+	} else {
+		return "";
+	}
+	directory /= IndexCacheDirectoryName;
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error || !std::filesystem::is_directory(directory, error))
+		return "";
+
+	return directory.string();
+}
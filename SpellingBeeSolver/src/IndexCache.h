@@ -0,0 +1,58 @@
+/*
+ * IndexCache.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef INDEXCACHE_H_
+#define INDEXCACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "CompiledDictionary.h"
+#include "LetterMaskIndex.h"
+
+constexpr const char *IndexCacheDirectoryName = "SpellingBeeSolver";
+
+/*	Keeps the index of a text dictionary as a compiled dictionary, so that
+ *	later runs against the same text can map it instead of rebuilding it
+ *
+ *	The cache lives in $XDG_CACHE_HOME/SpellingBeeSolver, or
+ *	~/.cache/SpellingBeeSolver, under a name made from the dictionary's
+ *	absolute path.  If neither directory can be used, it is kept next to
+ *	the dictionary.  A cached index is only used if the size, modification
+ *	time and hash of the text recorded in it match the text as it is now.
+ *	The size and time are checked first, so the whole text is only read
+ *	to hash it when the cache is likely to be used
+ */
+class IndexCache {
+private:
+	std::string m_dictionary_filename;
+	std::string m_cache_filename;
+	CompiledDictionarySource m_source;
+	bool m_source_described;
+	bool m_source_hashed;
+
+	IndexCache();
+
+public:
+	virtual ~IndexCache();
+	IndexCache(const std::string &dictionary_filename);
+
+	// opens the cached index if it was built from the text dictionary
+	//	as it is now.  Returns nullptr on a miss
+	std::unique_ptr<CompiledDictionary> load(void);
+	// saves 'index', which must have been built from the text described
+	//	by load(), so that a change made during the build is not hidden
+	bool save(const LetterMaskIndex &index);
+
+	const std::string &cacheFilename(void) const	{ return m_cache_filename; }
+
+	// returns the directory the cache is kept in, creating it if needed,
+	//	or an empty string if there is none
+	static std::string cacheDirectory(void);
+};
+
+#endif /* INDEXCACHE_H_ */
@@ -0,0 +1,9 @@
+/*
+ * IndexCache_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "IndexCache.h"
+
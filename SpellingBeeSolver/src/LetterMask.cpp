@@ -0,0 +1,393 @@
+/*
+ * LetterMask.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "LetterMask.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LETTER_MASK_X86 1
+#else
+#define LETTER_MASK_X86 0
+#endif
+
+typedef letter_mask_t (*letter_mask_kernel_t)(const char *word, size_t length);
+typedef size_t (*match_kernel_t)(const letter_mask_t *masks, size_t count,
+								 letter_mask_t allowed, letter_mask_t required,
+								 uint64_t *bitmap);
+typedef size_t (*query_kernel_t)(letter_mask_t mask, const letter_mask_t *allowed,
+								 const letter_mask_t *required, size_t count,
+								 uint64_t *bitmap);
+
+/* ************************************************************	*/
+/*							scalar kernel						*/
+/* ************************************************************	*/
+
+static constexpr std::array<letter_mask_t, 256> makeLetterBitTable(void) {
+	std::array<letter_mask_t, 256> table{};
+	for (int c = 0; c != 256; c++) {
+		table[c] = letterBit(static_cast<char>(c));
+	}
+	return table;
+}
+
+static constexpr std::array<letter_mask_t, 256> letter_bit_table = makeLetterBitTable();
+
+static letter_mask_t letterMaskScalar(const char *word, size_t length) {
+
+	letter_mask_t mask = 0;
+	for (size_t i = 0; i != length; i++) {
+		mask |= letter_bit_table[static_cast<unsigned char>(word[i])];
+	}
+	return mask;
+}
+
+static size_t matchLetterMasksScalar(const letter_mask_t *masks, size_t count,
+									 letter_mask_t allowed, letter_mask_t required,
+									 uint64_t *bitmap) {
+
+	size_t num_matches = 0;
+	letter_mask_t forbidden = ~allowed;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		size_t end = count - block * 64 < 64 ? count - block * 64 : 64;
+		for (size_t i = 0; i != end; i++) {
+			letter_mask_t mask = masks[block * 64 + i];
+			uint64_t match = (mask & forbidden) == 0 && (mask & required) == required;
+			bits |= match << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+static size_t matchQueriesScalar(letter_mask_t mask, const letter_mask_t *allowed,
+								 const letter_mask_t *required, size_t count,
+								 uint64_t *bitmap) {
+
+	size_t num_matches = 0;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		size_t end = count - block * 64 < 64 ? count - block * 64 : 64;
+		for (size_t i = 0; i != end; i++) {
+			size_t query = block * 64 + i;
+			uint64_t match = (mask & ~allowed[query]) == 0 &&
+							 (mask & required[query]) == required[query];
+			bits |= match << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+/* ************************************************************	*/
+/*							AVX2 kernels						*/
+/* ************************************************************	*/
+
+#if LETTER_MASK_X86
+
+// the smallest page size of any x86 processor
+constexpr uintptr_t LetterMaskPageSize = 4096;
+
+// returns 8 partial masks, one per 32 bit lane, whose OR is the mask
+//	of the first 'length' characters of 'chars'
+__attribute__((target("avx2")))
+static inline __m256i letterBitsAvx2(__m256i chars, int length) {
+
+	const __m256i lane = _mm256_setr_epi8(
+			 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+			16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+
+	// lower case, then 0 .. 25 for letters, anything else is not a letter
+	__m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)),
+									 _mm256_set1_epi8('a'));
+	__m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(NumberOfLetters-1)),
+										  letter);
+	// bit 31 is LetterMaskInvalid, and shifting by 255 gives 0
+	__m256i bit = _mm256_blendv_epi8(_mm256_set1_epi8(31), letter, is_letter);
+	__m256i in_word = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(length)), lane);
+	bit = _mm256_blendv_epi8(_mm256_set1_epi8(static_cast<char>(0xFF)), bit, in_word);
+
+	// widen 8 characters at a time to 32 bits, and shift a 1 into place
+	const __m256i one = _mm256_set1_epi32(1);
+	__m128i low = _mm256_castsi256_si128(bit);
+	__m128i high = _mm256_extracti128_si256(bit, 1);
+	__m256i bits = _mm256_sllv_epi32(one, _mm256_cvtepu8_epi32(low));
+	bits = _mm256_or_si256(bits, _mm256_sllv_epi32(one, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8))));
+	if (length > 16) {
+		bits = _mm256_or_si256(bits, _mm256_sllv_epi32(one, _mm256_cvtepu8_epi32(high)));
+		bits = _mm256_or_si256(bits, _mm256_sllv_epi32(one, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8))));
+	}
+	return bits;
+}
+
+// reads up to 31 bytes past the end of the word, see below
+__attribute__((target("avx2"), no_sanitize_address))
+static letter_mask_t letterMaskAvx2(const char *word, size_t length) {
+
+	__m256i bits = _mm256_setzero_si256();
+	size_t i = 0;
+
+	for (; i + 32 <= length; i += 32) {
+		__m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(word + i));
+		bits = _mm256_or_si256(bits, letterBitsAvx2(chars, 32));
+	}
+
+	// the characters past the end of the word are ignored, so reading them
+	//	is harmless as long as the read does not cross into the next page,
+	//	which may not be mapped.  Otherwise the rest of the word is copied
+	if (i != length) {
+		__m256i chars;
+		if ((reinterpret_cast<uintptr_t>(word + i) & (LetterMaskPageSize-1)) <= LetterMaskPageSize - 32) {
+			chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(word + i));
+		} else {
+			alignas(32) char tail[32];
+			memcpy(tail, word + i, length - i);
+			chars = _mm256_load_si256(reinterpret_cast<const __m256i *>(tail));
+		}
+		bits = _mm256_or_si256(bits, letterBitsAvx2(chars, static_cast<int>(length - i)));
+	}
+
+	__m128i half = _mm_or_si128(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+	half = _mm_or_si128(half, _mm_srli_si128(half, 8));
+	half = _mm_or_si128(half, _mm_srli_si128(half, 4));
+	return static_cast<letter_mask_t>(_mm_cvtsi128_si32(half));
+}
+
+// 8 masks per instruction
+__attribute__((target("avx2")))
+static size_t matchLetterMasksAvx2(const letter_mask_t *masks, size_t count,
+								   letter_mask_t allowed, letter_mask_t required,
+								   uint64_t *bitmap) {
+
+	const __m256i forbidden = _mm256_set1_epi32(static_cast<int>(~allowed));
+	const __m256i required_letters = _mm256_set1_epi32(static_cast<int>(required));
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	size_t num_matches = 0;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		for (size_t i = 0; i < 64 && block * 64 + i < count; i += 8) {
+			size_t first = block * 64 + i;
+			__m256i mask;
+			__m256i in_range;
+			if (first + 8 <= count) {
+				mask = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(masks + first));
+				in_range = _mm256_set1_epi32(-1);
+			} else {
+				// the masked lanes are not read, so this cannot fault
+				in_range = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count - first)), lane);
+				mask = _mm256_maskload_epi32(reinterpret_cast<const int *>(masks + first), in_range);
+			}
+			__m256i no_forbidden = _mm256_cmpeq_epi32(_mm256_and_si256(mask, forbidden), zero);
+			__m256i has_required = _mm256_cmpeq_epi32(_mm256_and_si256(mask, required_letters),
+													  required_letters);
+			__m256i match = _mm256_and_si256(_mm256_and_si256(no_forbidden, has_required), in_range);
+			uint64_t match_bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+			bits |= match_bits << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+// one mask against 8 queries per instruction
+__attribute__((target("avx2")))
+static size_t matchQueriesAvx2(letter_mask_t mask, const letter_mask_t *allowed,
+							   const letter_mask_t *required, size_t count,
+							   uint64_t *bitmap) {
+
+	const __m256i word = _mm256_set1_epi32(static_cast<int>(mask));
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	size_t num_matches = 0;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		for (size_t i = 0; i < 64 && block * 64 + i < count; i += 8) {
+			size_t first = block * 64 + i;
+			__m256i allowed_letters;
+			__m256i required_letters;
+			__m256i in_range;
+			if (first + 8 <= count) {
+				allowed_letters = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(allowed + first));
+				required_letters = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(required + first));
+				in_range = _mm256_set1_epi32(-1);
+			} else {
+				// the masked lanes are not read, so this cannot fault
+				in_range = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count - first)), lane);
+				allowed_letters = _mm256_maskload_epi32(reinterpret_cast<const int *>(allowed + first), in_range);
+				required_letters = _mm256_maskload_epi32(reinterpret_cast<const int *>(required + first), in_range);
+			}
+			__m256i no_forbidden = _mm256_cmpeq_epi32(_mm256_andnot_si256(allowed_letters, word), zero);
+			__m256i has_required = _mm256_cmpeq_epi32(_mm256_and_si256(word, required_letters),
+													  required_letters);
+			__m256i match = _mm256_and_si256(_mm256_and_si256(no_forbidden, has_required), in_range);
+			uint64_t match_bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+			bits |= match_bits << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+/* ************************************************************	*/
+/*							AVX-512 kernel						*/
+/* ************************************************************	*/
+
+// 16 masks per instruction
+__attribute__((target("avx512f")))
+static size_t matchLetterMasksAvx512(const letter_mask_t *masks, size_t count,
+									 letter_mask_t allowed, letter_mask_t required,
+									 uint64_t *bitmap) {
+
+	const __m512i forbidden = _mm512_set1_epi32(static_cast<int>(~allowed));
+	const __m512i required_letters = _mm512_set1_epi32(static_cast<int>(required));
+	size_t num_matches = 0;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		for (size_t i = 0; i < 64 && block * 64 + i < count; i += 16) {
+			size_t first = block * 64 + i;
+			size_t remaining = count - first;
+			// the masked lanes are not read, so this cannot fault
+			__mmask16 in_range = remaining >= 16 ? 0xFFFF : static_cast<__mmask16>((1u << remaining) - 1);
+			__m512i mask = _mm512_maskz_loadu_epi32(in_range, masks + first);
+			__mmask16 match = _mm512_mask_testn_epi32_mask(in_range, mask, forbidden);
+			match = _mm512_mask_cmpeq_epi32_mask(match, _mm512_and_si512(mask, required_letters),
+												 required_letters);
+			bits |= static_cast<uint64_t>(match) << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+// one mask against 16 queries per instruction
+__attribute__((target("avx512f")))
+static size_t matchQueriesAvx512(letter_mask_t mask, const letter_mask_t *allowed,
+								 const letter_mask_t *required, size_t count,
+								 uint64_t *bitmap) {
+
+	const __m512i word = _mm512_set1_epi32(static_cast<int>(mask));
+	size_t num_matches = 0;
+
+	for (size_t block = 0; block * 64 < count; block++) {
+		uint64_t bits = 0;
+		for (size_t i = 0; i < 64 && block * 64 + i < count; i += 16) {
+			size_t first = block * 64 + i;
+			size_t remaining = count - first;
+			// the masked lanes are not read, so this cannot fault
+			__mmask16 in_range = remaining >= 16 ? 0xFFFF : static_cast<__mmask16>((1u << remaining) - 1);
+			__m512i allowed_letters = _mm512_maskz_loadu_epi32(in_range, allowed + first);
+			__m512i required_letters = _mm512_maskz_loadu_epi32(in_range, required + first);
+			__m512i forbidden = _mm512_xor_si512(allowed_letters, _mm512_set1_epi32(-1));
+			__mmask16 match = _mm512_mask_testn_epi32_mask(in_range, word, forbidden);
+			match = _mm512_mask_cmpeq_epi32_mask(match, _mm512_and_si512(word, required_letters),
+												 required_letters);
+			bits |= static_cast<uint64_t>(match) << i;
+		}
+		bitmap[block] = bits;
+		num_matches += __builtin_popcountll(bits);
+	}
+	return num_matches;
+}
+
+#endif
+
+/* ************************************************************	*/
+/*							dispatch							*/
+/* ************************************************************	*/
+
+static letter_mask_kernel_t selectLetterMaskKernel(void) {
+
+#if LETTER_MASK_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return letterMaskAvx2;
+#endif
+	return letterMaskScalar;
+}
+
+static match_kernel_t selectMatchKernel(void) {
+
+#if LETTER_MASK_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return matchLetterMasksAvx512;
+	if (__builtin_cpu_supports("avx2"))
+		return matchLetterMasksAvx2;
+#endif
+	return matchLetterMasksScalar;
+}
+
+static query_kernel_t selectQueryKernel(void) {
+
+#if LETTER_MASK_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return matchQueriesAvx512;
+	if (__builtin_cpu_supports("avx2"))
+		return matchQueriesAvx2;
+#endif
+	return matchQueriesScalar;
+}
+
+letter_mask_t letterMask(std::string_view word) {
+
+	// chosen once, the first time a mask is computed
+	static const letter_mask_kernel_t kernel = selectLetterMaskKernel();
+
+	return kernel(word.data(), word.size());
+}
+
+letter_mask_t letterMask(const letters_t &letters) {
+
+	letter_mask_t mask = 0;
+	for (letter_t letter : letters) {
+		mask |= letterBit(letter);
+	}
+	return mask;
+}
+
+std::string letterString(letter_mask_t mask) {
+
+	std::string letters;
+	for (letter_mask_t bits = mask & AllLettersMask; bits != 0; bits &= bits - 1) {
+		letters += static_cast<char>('a' + __builtin_ctz(bits));
+	}
+	return letters;
+}
+
+size_t matchLetterMasks(const letter_mask_t *masks, size_t count,
+						letter_mask_t allowed, letter_mask_t required,
+						uint64_t *bitmap) {
+
+	static const match_kernel_t kernel = selectMatchKernel();
+
+	return kernel(masks, count, allowed, required, bitmap);
+}
+
+size_t matchQueries(letter_mask_t mask, const letter_mask_t *allowed,
+					const letter_mask_t *required, size_t count,
+					uint64_t *bitmap) {
+
+	static const query_kernel_t kernel = selectQueryKernel();
+
+	return kernel(mask, allowed, required, count, bitmap);
+}
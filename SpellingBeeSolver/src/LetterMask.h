@@ -0,0 +1,53 @@
+/*
+ * LetterMask.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef LETTERMASK_H_
+#define LETTERMASK_H_
+
+#include <string>
+#include <string_view>
+
+#include "SpellingBeeSolver.h"
+
+constexpr int NumberOfLetters = 26;
+constexpr letter_mask_t AllLettersMask = (1u << NumberOfLetters) - 1;
+// set by any character that is not a letter, so that
+//	the word can never be matched by a set of letters
+constexpr letter_mask_t LetterMaskInvalid = 1u << 31;
+
+// returns the bit for 'c' regardless of case,
+//	or LetterMaskInvalid if 'c' is not a letter
+constexpr letter_mask_t letterBit(char c) {
+	unsigned letter = static_cast<unsigned char>(c | 0x20) - static_cast<unsigned>('a');
+	return letter < NumberOfLetters ? 1u << letter : LetterMaskInvalid;
+}
+
+// returns the number of distinct letters in 'mask'
+constexpr int numberOfLetters(letter_mask_t mask) {
+	return __builtin_popcount(mask & AllLettersMask);
+}
+
+letter_mask_t letterMask(std::string_view word);
+letter_mask_t letterMask(const letters_t &letters);
+// the letters of 'mask', in alphabetical order
+std::string letterString(letter_mask_t mask);
+
+// sets bit (i % 64) of bitmap[i / 64] if masks[i] only uses letters in 'allowed'
+//	and uses every letter in 'required', for i in 0 .. count-1, and clears it
+//	otherwise.  'bitmap' must hold (count + 63) / 64 words
+//	returns the number of bits set
+size_t matchLetterMasks(const letter_mask_t *masks, size_t count,
+						letter_mask_t allowed, letter_mask_t required,
+						uint64_t *bitmap);
+// the same test the other way around, one mask against 'count' queries:
+//	sets bit i if 'mask' only uses letters in allowed[i] and uses every
+//	letter in required[i]
+size_t matchQueries(letter_mask_t mask, const letter_mask_t *allowed,
+					const letter_mask_t *required, size_t count,
+					uint64_t *bitmap);
+
+#endif /* LETTERMASK_H_ */
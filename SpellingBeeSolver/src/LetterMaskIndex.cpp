@@ -0,0 +1,203 @@
+/*
+ * LetterMaskIndex.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "LetterMaskIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+bool LetterMaskIndex::build(Dictionary &dictionary) {
+
+	clear();
+
+	if (!dictionary.open() || !dictionary.begining())
+		return false;
+
+	std::string_view batch[DefaultDictionaryBatchSize];
+	size_t num_words;
+	while ((num_words = dictionary.nextWords(batch)) != 0) {
+		for (size_t i = 0; i != num_words; i++) {
+			add(batch[i]);
+		}
+	}
+	bool is_read = !dictionary.isError();
+	// a dictionary that cannot be read again, such as a pipe, is left at
+	//	its end, which is not an error once all of it has been indexed
+	dictionary.begining();
+
+	return is_read;
+}
+
+bool LetterMaskIndex::build(std::string_view text, ThreadPool &pool) {
+
+	// the result of each task, indexed independently of the others
+	struct Chunk {
+		size_t begin;
+		size_t end;
+		std::vector<uint32_t> offsets;
+		std::vector<word_length_t> lengths;
+		std::vector<letter_mask_t> masks;
+	};
+
+	clear();
+
+	// offsets are 32 bits to keep the index compact
+	if (text.size() > UINT32_MAX)
+		return false;
+
+	if (text.empty())
+		return true;
+
+	size_t num_chunks = std::min(pool.size() * LetterMaskIndexTasksPerThread,
+								 text.size() / LetterMaskIndexMinBytesPerTask + 1);
+	std::vector<Chunk> chunks(num_chunks);
+
+	// each chunk starts at the beginning of a line
+	size_t begin = 0;
+	for (size_t i = 0; i != num_chunks; i++) {
+		size_t end = text.size() * (i+1) / num_chunks;
+		if (end < begin)
+			end = begin;
+		const char *newline = static_cast<const char *>(
+				memchr(text.data() + end, '\n', text.size() - end));
+		end = newline ? newline - text.data() + 1 : text.size();
+		chunks[i].begin = begin;
+		chunks[i].end = end;
+		begin = end;
+	}
+
+	pool.run(num_chunks, [&text, &chunks](size_t task) {
+		Chunk &chunk = chunks[task];
+		size_t line = chunk.begin;
+		while (line < chunk.end) {
+			const char *newline = static_cast<const char *>(
+					memchr(text.data() + line, '\n', chunk.end - line));
+			size_t line_end = newline ? newline - text.data() : chunk.end;
+			size_t length = line_end - line;
+			if (length != 0 && length <= LetterMaskIndexMaxWordLength) {
+				chunk.offsets.push_back(static_cast<uint32_t>(line));
+				chunk.lengths.push_back(static_cast<word_length_t>(length));
+				chunk.masks.push_back(letterMask(text.substr(line, length)));
+			}
+			line = line_end + 1;
+		}
+	});
+
+	for (Chunk &chunk : chunks) {
+		m_offsets_storage.insert(m_offsets_storage.end(), chunk.offsets.begin(), chunk.offsets.end());
+		m_lengths_storage.insert(m_lengths_storage.end(), chunk.lengths.begin(), chunk.lengths.end());
+		m_masks_storage.insert(m_masks_storage.end(), chunk.masks.begin(), chunk.masks.end());
+	}
+
+	useStorage();
+	m_pool = text;
+	return true;
+}
+
+void LetterMaskIndex::attach(std::string_view pool, const uint32_t *offsets,
+							 const word_length_t *lengths, const letter_mask_t *masks,
+							 size_t num_words) {
+
+	clear();
+
+	m_pool = pool;
+	m_offsets = offsets;
+	m_lengths = lengths;
+	m_masks = masks;
+	m_num_words = num_words;
+}
+
+void LetterMaskIndex::clear(void) {
+
+	m_pool_storage.clear();
+	m_offsets_storage.clear();
+	m_lengths_storage.clear();
+	m_masks_storage.clear();
+	useStorage();
+}
+
+void LetterMaskIndex::useStorage(void) {
+
+	m_pool = m_pool_storage;
+	m_offsets = m_offsets_storage.data();
+	m_lengths = m_lengths_storage.data();
+	m_masks = m_masks_storage.data();
+	m_num_words = m_masks_storage.size();
+}
+
+bool LetterMaskIndex::add(std::string_view word) {
+
+	if (word.empty() || word.size() > LetterMaskIndexMaxWordLength)
+		return false;
+
+	// offsets are 32 bits to keep the index compact
+	if (m_pool_storage.size() + word.size() > UINT32_MAX)
+		return false;
+
+	m_offsets_storage.push_back(static_cast<uint32_t>(m_pool_storage.size()));
+	m_lengths_storage.push_back(static_cast<word_length_t>(word.size()));
+	m_masks_storage.push_back(letterMask(word));
+	m_pool_storage.append(word);
+	// the storage may have moved
+	useStorage();
+	return true;
+}
+
+size_t LetterMaskIndex::find(letter_mask_t allowed, letter_mask_t required,
+							 std::vector<word_id_t> &matches) const {
+
+	return findInRange(0, m_num_words, allowed, required, matches);
+}
+
+size_t LetterMaskIndex::find(letter_mask_t allowed, letter_mask_t required,
+							 std::vector<word_id_t> &matches, ThreadPool &pool) const {
+
+	size_t num_ranges = std::min(pool.size() * LetterMaskIndexTasksPerThread,
+								 m_num_words / LetterMaskIndexMinWordsPerTask + 1);
+	std::vector<std::vector<word_id_t>> range_matches(num_ranges);
+
+	pool.run(num_ranges, [&](size_t task) {
+		size_t begin = m_num_words * task / num_ranges;
+		size_t end = m_num_words * (task+1) / num_ranges;
+		findInRange(begin, end, allowed, required, range_matches[task]);
+	});
+
+	// the ranges are in dictionary order, so the matches are too
+	size_t num_matches = 0;
+	for (std::vector<word_id_t> &range : range_matches) {
+		matches.insert(matches.end(), range.begin(), range.end());
+		num_matches += range.size();
+	}
+	return num_matches;
+}
+
+size_t LetterMaskIndex::findInRange(size_t begin, size_t end,
+									letter_mask_t allowed, letter_mask_t required,
+									std::vector<word_id_t> &matches) const {
+
+	// the masks are matched a block at a time into a bitmap,
+	//	which is then turned into word ids
+	uint64_t bitmap[LetterMaskIndexMatchBlockSize / 64];
+	size_t num_matches = 0;
+
+	for (size_t block = begin; block < end; block += LetterMaskIndexMatchBlockSize) {
+		size_t count = std::min(end - block, LetterMaskIndexMatchBlockSize);
+		if (matchLetterMasks(m_masks + block, count, allowed, required, bitmap) == 0)
+			continue;
+
+		for (size_t i = 0; i * 64 < count; i++) {
+			uint64_t bits = bitmap[i];
+			while (bits) {
+				size_t bit = __builtin_ctzll(bits);
+				matches.push_back(static_cast<word_id_t>(block + i * 64 + bit));
+				num_matches++;
+				bits &= bits - 1;
+			}
+		}
+	}
+	return num_matches;
+}
@@ -0,0 +1,108 @@
+/*
+ * LetterMaskIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef LETTERMASKINDEX_H_
+#define LETTERMASKINDEX_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Dictionary.h"
+#include "LetterMask.h"
+#include "SpellingBeeSolver.h"
+#include "ThreadPool.h"
+
+constexpr size_t LetterMaskIndexMaxWordLength = UINT16_MAX;
+// parallel work is split into about this many tasks per thread,
+//	so that threads that finish early can help the others
+constexpr size_t LetterMaskIndexTasksPerThread = 4;
+// but no task is smaller than this many words, or bytes of text
+constexpr size_t LetterMaskIndexMinWordsPerTask = 16384;
+constexpr size_t LetterMaskIndexMinBytesPerTask = 128 * 1024;
+// number of masks matched into a bitmap at a time, a multiple of 64
+constexpr size_t LetterMaskIndexMatchBlockSize = 4096;
+
+// The index is built once when the dictionary is loaded.  It holds every
+//	word of the dictionary back to back in a single pool, plus the offset,
+//	length and letter mask of each word, so that a search is a loop over
+//	an array of integers that does not allocate or touch the word text
+//
+//	The index either owns these arrays, when it is built from a Dictionary,
+//	or refers to arrays that were built elsewhere, such as the ones the
+//	compiler builds for the default dictionary
+class LetterMaskIndex {
+private:
+	std::string m_pool_storage;
+	std::vector<uint32_t> m_offsets_storage;
+	std::vector<word_length_t> m_lengths_storage;
+	std::vector<letter_mask_t> m_masks_storage;
+
+	std::string_view m_pool;
+	const uint32_t *m_offsets;
+	const word_length_t *m_lengths;
+	const letter_mask_t *m_masks;
+	size_t m_num_words;
+
+	// points the arrays at the storage owned by this index
+	void useStorage(void);
+	size_t findInRange(size_t begin, size_t end,
+					   letter_mask_t allowed, letter_mask_t required,
+					   std::vector<word_id_t> &matches) const;
+
+public:
+	LetterMaskIndex() :
+		m_offsets(nullptr),
+		m_lengths(nullptr),
+		m_masks(nullptr),
+		m_num_words(0) {}
+	virtual ~LetterMaskIndex() {}
+
+	// the arrays may refer to the index's own storage, so it is not copied
+	LetterMaskIndex(const LetterMaskIndex &other) = delete;
+	LetterMaskIndex& operator=(const LetterMaskIndex &other) = delete;
+
+	// reads every word from the beginning of 'dictionary'
+	//	empty words and words longer than LetterMaskIndexMaxWordLength are skipped
+	//	returns false if the dictionary could not be read to its end
+	bool build(Dictionary &dictionary);
+	// indexes the lines of 'text', such as a memory mapped dictionary file,
+	//	splitting it on line boundaries across the threads of 'pool'
+	//	the index refers to 'text' rather than copying it, so 'text'
+	//	must outlive the index.  Lines are skipped as in build()
+	//	returns false if 'text' is too large to index
+	bool build(std::string_view text, ThreadPool &pool);
+	// refers to arrays of 'num_words' entries built elsewhere,
+	//	which must outlive the index.  Word i is
+	//	pool.substr(offsets[i], lengths[i]) and has the letter mask masks[i]
+	void attach(std::string_view pool, const uint32_t *offsets,
+				const word_length_t *lengths, const letter_mask_t *masks,
+				size_t num_words);
+	void clear(void);
+
+	// adds 'word' to the end of an index that owns its storage
+	//	returns false if it was skipped
+	bool add(std::string_view word);
+
+	size_t size(void) const			{ return m_num_words; }
+	letter_mask_t mask(word_id_t id) const	{ return m_masks[id]; }
+	word_length_t length(word_id_t id) const	{ return m_lengths[id]; }
+	std::string_view word(word_id_t id) const {
+		return m_pool.substr(m_offsets[id], m_lengths[id]);
+	}
+
+	// appends the id of every word that only uses letters in 'allowed'
+	//	and uses every letter in 'required' to 'matches', in dictionary order
+	//	returns the number of words appended
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches) const;
+	// the same, with the words split into ranges across the threads of 'pool'
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches, ThreadPool &pool) const;
+};
+
+#endif /* LETTERMASKINDEX_H_ */
@@ -0,0 +1,9 @@
+/*
+ * LetterMaskIndex_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "LetterMaskIndex.h"
+
@@ -0,0 +1,9 @@
+/*
+ * LetterMask_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "LetterMask.h"
+
@@ -0,0 +1,104 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+	unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) :
+	m_data(other.m_data),
+	m_size(other.m_size),
+	m_mapped(other.m_mapped),
+	m_open_failed(other.m_open_failed) {
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapped = false;
+	other.m_open_failed = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile &&other) {
+	if (&other == this)
+		return *this;
+
+	unmap();
+
+	m_data = other.m_data;
+	other.m_data = nullptr;
+	m_size = other.m_size;
+	other.m_size = 0;
+	m_mapped = other.m_mapped;
+	other.m_mapped = false;
+	m_open_failed = other.m_open_failed;
+	other.m_open_failed = false;
+
+	return *this;
+}
+
+bool MappedFile::map(const std::string &filename) {
+
+	unmap();
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		m_open_failed = true;
+		return false;
+	}
+
+	// only regular files can be mapped, pipes and devices are reported
+	//	as errors so that the caller can read them some other way
+	struct stat file_status;
+	if (fstat(fd, &file_status) != 0 || !S_ISREG(file_status.st_mode)) {
+		::close(fd);
+		return false;
+	}
+
+	size_t size = static_cast<size_t>(file_status.st_size);
+	// an empty file cannot be mapped, but is a valid empty mapping
+	if (size == 0) {
+		::close(fd);
+		m_mapped = true;
+		return true;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after the file descriptor is closed
+	::close(fd);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = static_cast<const char *>(data);
+	m_size = size;
+	m_mapped = true;
+	return true;
+}
+
+void MappedFile::unmap(void) {
+
+	if (m_data) {
+		munmap(const_cast<char *>(m_data), m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_mapped = false;
+	m_open_failed = false;
+}
+
+void MappedFile::adviseSequential(void) const {
+
+	if (m_data) {
+		madvise(const_cast<char *>(m_data), m_size, MADV_SEQUENTIAL);
+	}
+}
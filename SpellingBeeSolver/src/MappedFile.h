@@ -0,0 +1,54 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// A whole regular file mapped read-only into memory
+//	An empty file is a valid, empty, mapping
+class MappedFile {
+private:
+	const char *m_data;
+	size_t m_size;
+	bool m_mapped;
+	bool m_open_failed;
+
+public:
+	MappedFile() :
+		m_data(nullptr),
+		m_size(0),
+		m_mapped(false),
+		m_open_failed(false) {}
+	virtual ~MappedFile();
+
+	// copying disallowed so that only one object owns the mapping
+	MappedFile(const MappedFile &other) = delete;
+	MappedFile& operator=(const MappedFile &other) = delete;
+	MappedFile(MappedFile &&other);
+	MappedFile& operator=(MappedFile &&other);
+
+	// returns false if the file cannot be opened, is not a regular file,
+	//	or cannot be mapped
+	bool map(const std::string &filename);
+	void unmap(void);
+	// tells the kernel the mapping will be read from start to end
+	void adviseSequential(void) const;
+
+	// true if the last map() failed because the file could not be opened,
+	//	rather than because it could not be mapped
+	bool isOpenError(void) const		{ return m_open_failed; }
+	bool isMapped(void) const			{ return m_mapped; }
+	const char *data(void) const		{ return m_data; }
+	size_t size(void) const				{ return m_size; }
+	std::string_view contents(void) const	{ return std::string_view(m_data, m_size); }
+};
+
+#endif /* MAPPEDFILE_H_ */
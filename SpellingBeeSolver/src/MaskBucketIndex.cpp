@@ -0,0 +1,136 @@
+/*
+ * MaskBucketIndex.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "MaskBucketIndex.h"
+
+#include <algorithm>
+
+void MaskBucketIndex::build(const LetterMaskIndex &index) {
+
+	clear();
+
+	// count the words in each bucket, then give each bucket its range
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		if (mask & LetterMaskInvalid)
+			continue;
+		m_buckets[mask].count++;
+	}
+
+	uint32_t begin = 0;
+	for (auto &entry : m_buckets) {
+		entry.second.begin = begin;
+		begin += entry.second.count;
+		entry.second.count = 0;
+	}
+
+	// ids are visited in increasing order, so each bucket is sorted
+	m_word_ids.resize(begin);
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		if (mask & LetterMaskInvalid)
+			continue;
+		Bucket &bucket = m_buckets[mask];
+		m_word_ids[bucket.begin + bucket.count++] = static_cast<word_id_t>(i);
+	}
+}
+
+void MaskBucketIndex::clear(void) {
+
+	m_buckets.clear();
+	m_word_ids.clear();
+}
+
+void MaskBucketIndex::appendBucket(letter_mask_t mask,
+								   std::vector<word_id_t> &matches) const {
+
+	auto it = m_buckets.find(mask);
+	if (it == m_buckets.end())
+		return;
+
+	const word_id_t *ids = m_word_ids.data() + it->second.begin;
+	matches.insert(matches.end(), ids, ids + it->second.count);
+}
+
+void MaskBucketIndex::appendBucketToEachLetter(letter_mask_t mask,
+		std::vector<std::vector<word_id_t>> &matches) const {
+
+	auto it = m_buckets.find(mask);
+	if (it == m_buckets.end())
+		return;
+
+	const word_id_t *ids = m_word_ids.data() + it->second.begin;
+	for (letter_mask_t letters = mask; letters != 0; letters &= letters - 1) {
+		std::vector<word_id_t> &letter_matches = matches[__builtin_ctz(letters)];
+		letter_matches.insert(letter_matches.end(), ids, ids + it->second.count);
+	}
+}
+
+size_t MaskBucketIndex::find(letter_mask_t allowed, letter_mask_t required,
+							 std::vector<word_id_t> &matches) const {
+
+	size_t first_match = matches.size();
+
+	allowed &= AllLettersMask;
+	if ((required & ~allowed) != 0)
+		return 0;
+
+	letter_mask_t optional = allowed & ~required;
+
+	if (numberOfLetters(optional) > MaskBucketIndexMaxSubsetLetters) {
+		for (auto &entry : m_buckets) {
+			letter_mask_t mask = entry.first;
+			if ((mask & ~allowed) == 0 && (mask & required) == required)
+				appendBucket(mask, matches);
+		}
+	} else {
+		// visit every subset of 'optional', including the empty set
+		letter_mask_t subset = optional;
+		while (true) {
+			appendBucket(required | subset, matches);
+			if (subset == 0)
+				break;
+			subset = (subset - 1) & optional;
+		}
+	}
+
+	// the buckets are each sorted, but are visited in mask order
+	std::sort(matches.begin() + first_match, matches.end());
+	return matches.size() - first_match;
+}
+
+size_t MaskBucketIndex::findEveryCenter(letter_mask_t allowed,
+		std::vector<std::vector<word_id_t>> &matches) const {
+
+	allowed &= AllLettersMask;
+	matches.resize(NumberOfLetters);
+
+	size_t first_match[NumberOfLetters];
+	for (int letter = 0; letter != NumberOfLetters; letter++) {
+		first_match[letter] = matches[letter].size();
+	}
+
+	if (numberOfLetters(allowed) > MaskBucketIndexMaxSubsetLetters) {
+		for (auto &entry : m_buckets) {
+			if ((entry.first & ~allowed) == 0)
+				appendBucketToEachLetter(entry.first, matches);
+		}
+	} else {
+		// the empty set has no letters to give its words to
+		for (letter_mask_t subset = allowed; subset != 0; subset = (subset - 1) & allowed) {
+			appendBucketToEachLetter(subset, matches);
+		}
+	}
+
+	size_t num_matches = 0;
+	for (letter_mask_t letters = allowed; letters != 0; letters &= letters - 1) {
+		int letter = __builtin_ctz(letters);
+		std::sort(matches[letter].begin() + first_match[letter], matches[letter].end());
+		num_matches += matches[letter].size() - first_match[letter];
+	}
+	return num_matches;
+}
@@ -0,0 +1,69 @@
+/*
+ * MaskBucketIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef MASKBUCKETINDEX_H_
+#define MASKBUCKETINDEX_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "LetterMaskIndex.h"
+#include "SearchEngine.h"
+#include "SpellingBeeSolver.h"
+
+// enumerating more subsets than this is slower than visiting every bucket
+constexpr int MaskBucketIndexMaxSubsetLetters = 16;
+
+// Groups the words of a LetterMaskIndex by their distinct-letter mask
+//	The ids of all the words in a bucket are stored contiguously,
+//	in dictionary order, so a bucket is just a range of m_word_ids
+class MaskBucketIndex: public SearchEngine {
+private:
+	struct Bucket {
+		uint32_t begin;
+		uint32_t count;
+	};
+
+	std::unordered_map<letter_mask_t, Bucket> m_buckets;
+	std::vector<word_id_t> m_word_ids;
+
+	void appendBucket(letter_mask_t mask, std::vector<word_id_t> &matches) const;
+	// appends the words of the bucket 'mask' to matches[letter]
+	//	for every letter in 'mask'
+	void appendBucketToEachLetter(letter_mask_t mask,
+								  std::vector<std::vector<word_id_t>> &matches) const;
+
+public:
+	MaskBucketIndex() {}
+	virtual ~MaskBucketIndex() {}
+
+	// words containing a character that is not a letter are not added
+	void build(const LetterMaskIndex &index);
+	void clear(void);
+
+	size_t numberOfBuckets(void) const	{ return m_buckets.size(); }
+	size_t size(void) const				{ return m_word_ids.size(); }
+
+	// appends the id of every word that only uses letters in 'allowed'
+	//	and uses every letter in 'required' to 'matches', in dictionary order
+	//	only the buckets of the subsets of 'allowed' that contain 'required'
+	//	are visited, so the cost does not depend on the size of the dictionary
+	//	returns the number of words appended
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches) const;
+	// finds the words for every choice of center letter in 'allowed' at once:
+	//	appends the id of every word that only uses letters in 'allowed' and
+	//	uses the letter i to matches[i], in dictionary order, where 'matches'
+	//	is resized to hold one list for each of the NumberOfLetters letters
+	//	each subset of 'allowed' is visited once and its words are given to
+	//	every letter it contains, so this costs about as much as one find()
+	//	returns the number of words appended to all of the lists
+	size_t findEveryCenter(letter_mask_t allowed,
+						   std::vector<std::vector<word_id_t>> &matches) const;
+};
+
+#endif /* MASKBUCKETINDEX_H_ */
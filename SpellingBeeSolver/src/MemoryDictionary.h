@@ -107,6 +107,27 @@ public:
 		}
 	}
 
+	bool	nextWordView(std::string_view &word) {
+		if (!m_is_open ||
+			m_next_word >= m_num_words ||
+			m_array == nullptr) {
+			return false;
+		} else {
+			word = m_array[m_next_word++];
+			return true;
+		}
+	}
+
+	size_t	nextWords(std::span<std::string_view> words) {
+		size_t num_words = 0;
+		if (!m_is_open || m_array == nullptr)
+			return num_words;
+		while (num_words != words.size() && m_next_word < m_num_words) {
+			words[num_words++] = m_array[m_next_word++];
+		}
+		return num_words;
+	}
+
 	bool	isError(void) const {
 		if (m_array == nullptr) {
 			return true;
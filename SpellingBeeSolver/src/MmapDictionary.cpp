@@ -0,0 +1,195 @@
+/*
+ * MmapDictionary.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "MmapDictionary.h"
+
+#include <cstring>
+
+MmapDictionary::MmapDictionary() :
+	m_filename(""),
+	m_next(0),
+	m_state(MmapDictionaryState::FILE_NOT_MAPPED) {}
+
+MmapDictionary::~MmapDictionary() {
+	unmap();
+}
+
+MmapDictionary::MmapDictionary(MmapDictionary &&other) :
+	m_filename(std::move(other.m_filename)),
+	m_file(std::move(other.m_file)),
+	m_next(other.m_next),
+	m_state(other.m_state) {
+
+	other.m_next = 0;
+	other.m_state = MmapDictionaryState::FILE_NOT_MAPPED;
+}
+
+MmapDictionary& MmapDictionary::operator=(MmapDictionary &&other) {
+	if (&other == this)
+		return *this;
+
+	unmap();
+
+	m_filename = std::move(other.m_filename);
+	m_file = std::move(other.m_file);
+	m_next = other.m_next;
+	other.m_next = 0;
+	m_state = other.m_state;
+	other.m_state = MmapDictionaryState::FILE_NOT_MAPPED;
+
+	return *this;
+}
+
+MmapDictionary::MmapDictionary(const std::string filename) :
+	m_filename(filename),
+	m_next(0),
+	m_state(MmapDictionaryState::FILE_NOT_MAPPED) {
+
+	map();
+}
+
+bool MmapDictionary::map(void) {
+
+	m_next = 0;
+	if (!m_file.map(m_filename)) {
+		m_state = m_file.isOpenError() ? MmapDictionaryState::FILE_OPEN_ERROR :
+										 MmapDictionaryState::FILE_MAP_ERROR;
+		return false;
+	}
+
+	m_file.adviseSequential();
+	m_state = MmapDictionaryState::FILE_MAPPED;
+	return true;
+}
+
+void MmapDictionary::unmap(void) {
+
+	m_file.unmap();
+	m_next = 0;
+	m_state = MmapDictionaryState::FILE_NOT_MAPPED;
+}
+
+//	functions inherited from base class Dictionary
+bool MmapDictionary::open(void) {
+
+	if (isOpen())
+		return begining();
+
+	if (m_filename.empty())
+		return false;
+
+	return map();
+}
+
+bool MmapDictionary::close(void) {
+
+	unmap();
+	return true;
+}
+
+bool MmapDictionary::begining(void) {
+
+	if (!isOpen())
+		return false;
+
+	m_next = 0;
+	return true;
+}
+
+std::string MmapDictionary::nextWord(void) {
+
+	std::string_view word;
+	if (!nextWordView(word))
+		return std::string("");
+
+	return std::string(word);
+}
+
+bool MmapDictionary::isOpen(void) const {
+	return m_state == MmapDictionaryState::FILE_MAPPED;
+}
+
+bool MmapDictionary::isNext(void) const {
+	return isOpen() && m_next < m_file.size();
+}
+
+bool MmapDictionary::isError(void) const {
+	return m_state == MmapDictionaryState::FILE_OPEN_ERROR ||
+		   m_state == MmapDictionaryState::FILE_MAP_ERROR;
+}
+
+bool MmapDictionary::nextWordView(std::string_view &word) {
+
+	if (!isNext())
+		return false;
+
+	const char *start = m_file.data() + m_next;
+	size_t remaining = m_file.size() - m_next;
+	const char *end = static_cast<const char *>(memchr(start, '\n', remaining));
+
+	if (end == nullptr) {
+		// the last line does not end in '\n'
+		word = std::string_view(start, remaining);
+		m_next = m_file.size();
+	} else {
+		word = std::string_view(start, end - start);
+		m_next += word.size() + 1;
+	}
+	return true;
+}
+
+size_t MmapDictionary::nextWords(std::span<std::string_view> words) {
+
+	size_t num_words = 0;
+	while (num_words != words.size() && nextWordView(words[num_words])) {
+		num_words++;
+	}
+	return num_words;
+}
+
+//	functions specific to this class
+std::string MmapDictionary::filename(void) const {
+	return m_filename;
+}
+
+MmapDictionaryState MmapDictionary::getState() const {
+	return m_state;
+}
+
+std::string_view MmapDictionary::contents(void) const {
+	return m_file.contents();
+}
+
+/* ************************************************************	*/
+/*					enum class MmapDictionaryState				*/
+/* ************************************************************	*/
+
+#undef MMAP_DICTIONARY_STATE
+#define MMAP_DICTIONARY_STATE(e) #e,
+static std::string MmapDictionaryStateStrings[] = {
+		MMAP_DICTIONARY_STATES
+};
+
+static bool isValid(MmapDictionaryState state) {
+	switch(state) {
+	case MmapDictionaryState::FILE_NOT_MAPPED:
+	case MmapDictionaryState::FILE_MAPPED:
+	case MmapDictionaryState::FILE_OPEN_ERROR:
+	case MmapDictionaryState::FILE_MAP_ERROR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::string toString(MmapDictionaryState state) {
+	if (isValid(state)) {
+		int i = static_cast<int>(state);
+		return MmapDictionaryStateStrings[i];
+	}
+	return "INVALID MmapDictionaryState";
+}
@@ -0,0 +1,88 @@
+/*
+ * MmapDictionary.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef MMAPDICTIONARY_H_
+#define MMAPDICTIONARY_H_
+
+#include "Dictionary.h"
+
+#include <string>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "SpellingBeeSolver.h"
+
+#undef MMAP_DICTIONARY_STATE
+#define MMAP_DICTIONARY_STATES \
+	MMAP_DICTIONARY_STATE(FILE_NOT_MAPPED)\
+	MMAP_DICTIONARY_STATE(FILE_MAPPED)\
+	MMAP_DICTIONARY_STATE(FILE_OPEN_ERROR)\
+	MMAP_DICTIONARY_STATE(FILE_MAP_ERROR)
+
+#define MMAP_DICTIONARY_STATE(e)	e,
+
+enum class MmapDictionaryState {
+	MMAP_DICTIONARY_STATES
+};
+
+std::string toString(MmapDictionaryState state);
+
+// Maps the whole dictionary file read-only into memory and walks it
+//	one line (word) at a time.  Words are lent out as views into the
+//	mapping, so reading the dictionary does not touch the heap
+class MmapDictionary: public Dictionary {
+private:
+	std::string m_filename;
+	MappedFile m_file;
+	// offset of the first character of the next word
+	size_t m_next;
+	MmapDictionaryState m_state;
+
+	MmapDictionary();
+	bool map(void);
+	void unmap(void);
+
+public:
+	// Rule of Five
+	virtual ~MmapDictionary();
+	// copy constructor and copy assignment operator
+	//	disallowed so that only one object owns the mapping
+	MmapDictionary(const MmapDictionary &other) = delete;
+	MmapDictionary& operator=(const MmapDictionary &other) = delete;
+	MmapDictionary(MmapDictionary &&other);
+	MmapDictionary& operator=(MmapDictionary &&other);
+
+	//	Resource Acquisition is Initialization
+	MmapDictionary(const std::string filename);
+
+	/*	**********************************************	*/
+	/*	functions inherited from base class Dictionary  */
+	/* 	**********************************************	*/
+
+	// maps the file if it is not already mapped, and rewinds to the first word
+	bool open(void);
+	// unmaps the file, views previously returned are no longer valid
+	bool close(void);
+	bool begining(void);
+	std::string nextWord(void);
+	// sets 'word' to the next line of the file, without the '\n'
+	//	the view is valid until the file is closed
+	//	returns false if there are no more words
+	bool nextWordView(std::string_view &word);
+	size_t nextWords(std::span<std::string_view> words);
+	bool isOpen(void) const;
+	bool isNext(void) const;
+	bool isError(void) const;
+
+	//	functions specific to this class
+	std::string	filename(void) const;
+	MmapDictionaryState getState() const;
+	// the whole file, valid until the file is closed
+	std::string_view contents(void) const;
+};
+
+#endif /* MMAPDICTIONARY_H_ */
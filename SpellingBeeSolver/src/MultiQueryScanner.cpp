@@ -0,0 +1,85 @@
+/*
+ * MultiQueryScanner.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "MultiQueryScanner.h"
+
+#include "LetterMask.h"
+
+size_t MultiQueryScanner::addQuery(letter_mask_t allowed, letter_mask_t required,
+								   word_length_t min_length) {
+
+	m_allowed.push_back(allowed);
+	m_required.push_back(required);
+	m_min_length.push_back(min_length);
+	m_any_allowed |= allowed;
+	m_matches.emplace_back();
+	return m_allowed.size() - 1;
+}
+
+void MultiQueryScanner::clear(void) {
+
+	m_allowed.clear();
+	m_required.clear();
+	m_min_length.clear();
+	m_any_allowed = 0;
+	m_words.clear();
+	m_matches.clear();
+	m_words_scanned = 0;
+}
+
+bool MultiQueryScanner::scan(Dictionary &dictionary) {
+
+	m_words.clear();
+	for (std::vector<word_id_t> &matches : m_matches) {
+		matches.clear();
+	}
+	m_words_scanned = 0;
+
+	if (!dictionary.open() || !dictionary.begining())
+		return false;
+
+	size_t num_queries = m_allowed.size();
+	std::vector<uint64_t> bitmap((num_queries + 63) / 64);
+	std::vector<size_t> matched_queries;
+	std::string_view batch[DefaultDictionaryBatchSize];
+	size_t num_words;
+	while ((num_words = dictionary.nextWords(batch)) != 0) {
+		for (size_t i = 0; i != num_words; i++) {
+			std::string_view word = batch[i];
+			if (word.empty() || word.size() > LetterMaskIndexMaxWordLength)
+				continue;
+			m_words_scanned++;
+
+			letter_mask_t mask = letterMask(word);
+			if ((mask & ~m_any_allowed) != 0 ||
+				matchQueries(mask, m_allowed.data(), m_required.data(),
+							 num_queries, bitmap.data()) == 0)
+				continue;
+
+			// the word is only kept if it is long enough for one of the queries
+			matched_queries.clear();
+			for (size_t block = 0; block != bitmap.size(); block++) {
+				for (uint64_t bits = bitmap[block]; bits != 0; bits &= bits - 1) {
+					size_t query = block * 64 + __builtin_ctzll(bits);
+					if (word.size() >= m_min_length[query])
+						matched_queries.push_back(query);
+				}
+			}
+			if (matched_queries.empty() || !m_words.add(word))
+				continue;
+			word_id_t id = m_words.size() - 1;
+			for (size_t query : matched_queries) {
+				m_matches[query].push_back(id);
+			}
+		}
+	}
+	// rewinding a dictionary that cannot be read twice is not an error here
+	bool read_every_word = !dictionary.isError();
+	dictionary.begining();
+
+	return read_every_word;
+}
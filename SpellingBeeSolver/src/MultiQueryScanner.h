@@ -0,0 +1,61 @@
+/*
+ * MultiQueryScanner.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef MULTIQUERYSCANNER_H_
+#define MULTIQUERYSCANNER_H_
+
+#include <string_view>
+#include <vector>
+
+#include "Dictionary.h"
+#include "LetterMaskIndex.h"
+#include "SpellingBeeSolver.h"
+
+// Answers many searches with a single pass over a dictionary, without
+//	indexing it first, for dictionaries that can only be read a word at
+//	a time.  Each word is read once and tested against every query at
+//	once, see matchQueries().  Only the words that match a query are kept
+class MultiQueryScanner {
+private:
+	std::vector<letter_mask_t> m_allowed;
+	std::vector<letter_mask_t> m_required;
+	std::vector<word_length_t> m_min_length;
+	// every letter that any query allows, a word using any other
+	//	letter cannot match and is not tested against the queries
+	letter_mask_t m_any_allowed;
+	// the words that matched at least one query, each kept once
+	LetterMaskIndex m_words;
+	std::vector<std::vector<word_id_t>> m_matches;
+	size_t m_words_scanned;
+
+public:
+	MultiQueryScanner() :
+		m_any_allowed(0),
+		m_words_scanned(0) {}
+	virtual ~MultiQueryScanner() {}
+
+	// adds a query for the words that only use letters in 'allowed'
+	//	and use every letter in 'required', and are at least 'min_length'
+	//	long.  Returns its number
+	size_t addQuery(letter_mask_t allowed, letter_mask_t required,
+					word_length_t min_length = 0);
+	// removes every query, and the results of the last scan
+	void clear(void);
+
+	// reads every word from the beginning of 'dictionary' and finds the
+	//	matches of every query.  Words are skipped as in LetterMaskIndex
+	//	returns false if the dictionary is in an error state
+	bool scan(Dictionary &dictionary);
+
+	size_t numberOfQueries(void) const	{ return m_allowed.size(); }
+	size_t wordsScanned(void) const		{ return m_words_scanned; }
+	// the matches of query 'query', in dictionary order, as ids into words()
+	const std::vector<word_id_t> &matches(size_t query) const	{ return m_matches[query]; }
+	const LetterMaskIndex &words(void) const	{ return m_words; }
+};
+
+#endif /* MULTIQUERYSCANNER_H_ */
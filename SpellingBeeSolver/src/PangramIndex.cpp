@@ -0,0 +1,69 @@
+/*
+ * PangramIndex.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "PangramIndex.h"
+
+#include <algorithm>
+
+PangramIndex::PangramIndex() :
+	m_num_letters(0) {}
+
+void PangramIndex::build(const LetterMaskIndex &index, int num_letters) {
+
+	clear();
+	m_num_letters = num_letters;
+
+	// count the words of each letter set, then give each set its range
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		if ((mask & LetterMaskInvalid) == 0 && ::numberOfLetters(mask) == num_letters)
+			m_letter_sets[mask].count++;
+	}
+
+	m_sorted_letter_sets.reserve(m_letter_sets.size());
+	for (auto &entry : m_letter_sets) {
+		m_sorted_letter_sets.push_back(entry.first);
+	}
+	std::sort(m_sorted_letter_sets.begin(), m_sorted_letter_sets.end());
+
+	uint32_t begin = 0;
+	for (letter_mask_t letters : m_sorted_letter_sets) {
+		LetterSet &set = m_letter_sets[letters];
+		set.begin = begin;
+		begin += set.count;
+		set.count = 0;
+	}
+
+	// ids are visited in increasing order, so each set is sorted
+	m_word_ids.resize(begin);
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		if ((mask & LetterMaskInvalid) || ::numberOfLetters(mask) != num_letters)
+			continue;
+		LetterSet &set = m_letter_sets[mask];
+		m_word_ids[set.begin + set.count++] = static_cast<word_id_t>(i);
+	}
+}
+
+void PangramIndex::clear(void) {
+
+	m_num_letters = 0;
+	m_letter_sets.clear();
+	m_sorted_letter_sets.clear();
+	m_word_ids.clear();
+}
+
+size_t PangramIndex::find(letter_mask_t letters, std::vector<word_id_t> &matches) const {
+
+	auto it = m_letter_sets.find(letters);
+	if (it == m_letter_sets.end())
+		return 0;
+
+	const word_id_t *ids = m_word_ids.data() + it->second.begin;
+	matches.insert(matches.end(), ids, ids + it->second.count);
+	return it->second.count;
+}
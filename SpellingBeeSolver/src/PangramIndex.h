@@ -0,0 +1,56 @@
+/*
+ * PangramIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef PANGRAMINDEX_H_
+#define PANGRAMINDEX_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "LetterMask.h"
+#include "LetterMaskIndex.h"
+#include "SpellingBeeSolver.h"
+
+// The words of a LetterMaskIndex that use exactly 'num_letters' distinct
+//	letters, grouped by their distinct-letter mask.  These are the pangrams
+//	of every puzzle with that many letters, so the pangrams of a puzzle are
+//	one lookup, and the puzzles that have any are the keys of the table
+class PangramIndex {
+private:
+	struct LetterSet {
+		uint32_t begin;
+		uint32_t count;
+	};
+
+	int m_num_letters;
+	std::unordered_map<letter_mask_t, LetterSet> m_letter_sets;
+	// the keys of m_letter_sets, in increasing order
+	std::vector<letter_mask_t> m_sorted_letter_sets;
+	std::vector<word_id_t> m_word_ids;
+
+public:
+	PangramIndex();
+	virtual ~PangramIndex() {}
+
+	// words containing a character that is not a letter are not added
+	void build(const LetterMaskIndex &index, int num_letters);
+	void clear(void);
+
+	int numberOfLetters(void) const		{ return m_num_letters; }
+	size_t size(void) const				{ return m_word_ids.size(); }
+	// every set of letters that has a pangram, in increasing mask order
+	const std::vector<letter_mask_t> &letterSets(void) const {
+		return m_sorted_letter_sets;
+	}
+
+	// appends the id of every word that uses all of 'letters' and no
+	//	other letter to 'matches', in dictionary order, if 'letters' has
+	//	numberOfLetters() letters.  returns the number of words appended
+	size_t find(letter_mask_t letters, std::vector<word_id_t> &matches) const;
+};
+
+#endif /* PANGRAMINDEX_H_ */
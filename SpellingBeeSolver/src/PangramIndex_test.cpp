@@ -0,0 +1,9 @@
+/*
+ * PangramIndex_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "PangramIndex.h"
+
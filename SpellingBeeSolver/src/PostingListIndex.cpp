@@ -0,0 +1,141 @@
+/*
+ * PostingListIndex.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "PostingListIndex.h"
+
+#include <algorithm>
+
+void PostingListIndex::build(const LetterMaskIndex &index) {
+
+	clear();
+
+	m_num_words = index.size();
+	for (size_t i = 0; i != m_num_words; i++) {
+		letter_mask_t mask = index.mask(i);
+		if (mask & LetterMaskInvalid)
+			m_not_letters.add(i);
+		for (letter_mask_t bits = mask & AllLettersMask; bits != 0; bits &= bits - 1) {
+			m_letters[__builtin_ctz(bits)].add(i);
+		}
+	}
+
+	for (CompressedBitmap &letter : m_letters) {
+		letter.shrinkToFit();
+	}
+	m_not_letters.shrinkToFit();
+
+	for (int letter = 0; letter != NumberOfLetters; letter++) {
+		m_letters_by_frequency[letter] = letter;
+	}
+	std::stable_sort(m_letters_by_frequency, m_letters_by_frequency + NumberOfLetters,
+					 [this](int a, int b) { return m_letters[a].size() > m_letters[b].size(); });
+}
+
+void PostingListIndex::clear(void) {
+
+	for (CompressedBitmap &letter : m_letters) {
+		letter.clear();
+	}
+	m_not_letters.clear();
+	m_num_words = 0;
+}
+
+size_t PostingListIndex::memoryUsed(void) const {
+
+	size_t bytes = m_not_letters.memoryUsed();
+	for (const CompressedBitmap &letter : m_letters) {
+		bytes += letter.memoryUsed();
+	}
+	return bytes;
+}
+
+void PostingListIndex::appendIds(word_id_t first_id, const uint64_t *bits, uint32_t num_words,
+								 std::vector<word_id_t> &matches) {
+
+	for (uint32_t i = 0; i != num_words; i++) {
+		for (uint64_t word_bits = bits[i]; word_bits != 0; word_bits &= word_bits - 1) {
+			matches.push_back(first_id + i * 64 + __builtin_ctzll(word_bits));
+		}
+	}
+}
+
+// whether any bit of the block is set
+static bool isAnyBitSet(const uint64_t *bits, uint32_t num_words) {
+
+	uint64_t any = 0;
+	for (uint32_t i = 0; i != num_words; i++) {
+		any |= bits[i];
+	}
+	return any != 0;
+}
+
+size_t PostingListIndex::find(letter_mask_t allowed, letter_mask_t required,
+							  std::vector<word_id_t> &matches) const {
+
+	size_t first_match = matches.size();
+
+	if ((required & ~allowed) != 0 || (required & LetterMaskInvalid) != 0)
+		return 0;
+
+	// the rarest required letter rules out the most words
+	const CompressedBitmap *rarest = nullptr;
+	for (letter_mask_t bits = required; bits != 0; bits &= bits - 1) {
+		const CompressedBitmap &letter = m_letters[__builtin_ctz(bits)];
+		if (!rarest || letter.size() < rarest->size())
+			rarest = &letter;
+	}
+
+	const CompressedBitmap *forbidden[NumberOfLetters];
+	int num_forbidden = 0;
+	for (int letter : m_letters_by_frequency) {
+		if ((allowed & (1u << letter)) == 0)
+			forbidden[num_forbidden++] = &m_letters[letter];
+	}
+
+	uint64_t bits[PostingListIndexBlockWords];
+	for (size_t first_id = 0; first_id < m_num_words; first_id += CompressedBitmapChunkSize) {
+		uint32_t chunk = first_id / CompressedBitmapChunkSize;
+		if (rarest && rarest->isChunkEmpty(chunk))
+			continue;
+
+		// the last chunk may not be full
+		size_t chunk_ids = std::min<size_t>(m_num_words - first_id, CompressedBitmapChunkSize);
+		uint32_t chunk_words = (chunk_ids + 63) / 64;
+		for (uint32_t first_word = 0; first_word < chunk_words; first_word += PostingListIndexBlockWords) {
+			uint32_t num_words = std::min(PostingListIndexBlockWords, chunk_words - first_word);
+
+			if (rarest) {
+				rarest->copyChunk(chunk, first_word, num_words, bits);
+				for (letter_mask_t letters = required; letters != 0; letters &= letters - 1) {
+					const CompressedBitmap &letter = m_letters[__builtin_ctz(letters)];
+					if (&letter != rarest)
+						letter.andChunk(chunk, first_word, num_words, bits);
+				}
+			} else {
+				for (uint32_t i = 0; i != num_words; i++) {
+					size_t first_bit = size_t(first_word + i) * 64;
+					bits[i] = first_bit + 64 <= chunk_ids ? ~uint64_t(0) :
+							  (uint64_t(1) << (chunk_ids - first_bit)) - 1;
+				}
+			}
+
+			bool any = isAnyBitSet(bits, num_words);
+			for (int i = 0; any && i != num_forbidden; i++) {
+				forbidden[i]->andNotChunk(chunk, first_word, num_words, bits);
+				any = isAnyBitSet(bits, num_words);
+			}
+			if (!any)
+				continue;
+			if ((allowed & LetterMaskInvalid) == 0)
+				m_not_letters.andNotChunk(chunk, first_word, num_words, bits);
+
+			appendIds(first_id + first_word * 64, bits, num_words, matches);
+		}
+	}
+
+	return matches.size() - first_match;
+}
@@ -0,0 +1,60 @@
+/*
+ * PostingListIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef POSTINGLISTINDEX_H_
+#define POSTINGLISTINDEX_H_
+
+#include <vector>
+
+#include "CompressedBitmap.h"
+#include "LetterMask.h"
+#include "LetterMaskIndex.h"
+#include "SearchEngine.h"
+#include "SpellingBeeSolver.h"
+
+// the number of 64 bit words of ids that are combined at a time, so that
+//	the part of every list that is being combined stays in the cache
+constexpr uint32_t PostingListIndexBlockWords = 64;
+
+// An inverted index of the words of a LetterMaskIndex: for each letter,
+//	the ids of the words that use it, as a compressed bitmap
+//
+//	A search starts from the words that use the rarest required letter,
+//	keeps those that use the other required letters, and removes those
+//	that use any letter that is not allowed, a block of ids at a time.
+//	The letters that are not allowed are taken from the most common to
+//	the least, and a block is finished as soon as no word is left in it
+class PostingListIndex: public SearchEngine {
+private:
+	CompressedBitmap m_letters[NumberOfLetters];
+	// the words with a character that is not a letter
+	CompressedBitmap m_not_letters;
+	// the letters, from the one the most words use to the one the fewest use
+	int m_letters_by_frequency[NumberOfLetters];
+	size_t m_num_words;
+
+	// appends the ids of the words in a block of 'bits' to 'matches'
+	static void appendIds(word_id_t first_id, const uint64_t *bits, uint32_t num_words,
+						  std::vector<word_id_t> &matches);
+
+public:
+	PostingListIndex() :
+		m_num_words(0) {}
+	virtual ~PostingListIndex() {}
+
+	void build(const LetterMaskIndex &index);
+	void clear(void);
+
+	size_t size(void) const		{ return m_num_words; }
+	// the number of bytes the posting lists take
+	size_t memoryUsed(void) const;
+
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches) const;
+};
+
+#endif /* POSTINGLISTINDEX_H_ */
@@ -0,0 +1,72 @@
+/*
+ * Puzzle.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "Puzzle.h"
+
+#include "LetterMask.h"
+
+static bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+// removes and returns the first run of characters that are not spaces
+static std::string_view nextToken(std::string_view &line) {
+
+	while (!line.empty() && isSpace(line.front()))
+		line.remove_prefix(1);
+	size_t end = 0;
+	while (end != line.size() && !isSpace(line[end]))
+		end++;
+	std::string_view token = line.substr(0, end);
+	line.remove_prefix(end);
+	return token;
+}
+
+bool parsePuzzle(std::string_view line, int min_letters, int max_letters, Puzzle &puzzle) {
+
+	std::string_view letters = nextToken(line);
+	std::string_view center = nextToken(line);
+	if (!nextToken(line).empty())
+		return false;
+
+	puzzle = makePuzzle(letters);
+	if (!center.empty()) {
+		if (center.size() != 1 || letterBit(center[0]) == LetterMaskInvalid ||
+			!applyNytRules(puzzle, center[0]))
+			return false;
+	}
+
+	int num_letters = numberOfLetters(puzzle.allowed);
+	return (puzzle.allowed & LetterMaskInvalid) == 0 &&
+		   num_letters >= min_letters && num_letters <= max_letters;
+}
+
+Puzzle makePuzzle(std::string_view letters) {
+
+	Puzzle puzzle;
+	puzzle.letters = letters;
+	puzzle.center = PuzzleNoCenter;
+	puzzle.allowed = letterMask(letters);
+	puzzle.required = puzzle.allowed;
+	puzzle.min_length = 0;
+	return puzzle;
+}
+
+bool applyNytRules(Puzzle &puzzle, char center) {
+
+	if (center != PuzzleNoCenter && (letterBit(center) & puzzle.allowed) == 0)
+		return false;
+
+	if (center != PuzzleNoCenter)
+		puzzle.center = center;
+	else if (puzzle.center == PuzzleNoCenter && !puzzle.letters.empty())
+		puzzle.center = puzzle.letters[0];
+
+	puzzle.required = letterBit(puzzle.center);
+	puzzle.min_length = PuzzleNytMinWordLength;
+	return true;
+}
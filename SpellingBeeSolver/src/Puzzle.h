@@ -0,0 +1,59 @@
+/*
+ * Puzzle.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef PUZZLE_H_
+#define PUZZLE_H_
+
+#include <string>
+#include <string_view>
+
+#include "SpellingBeeSolver.h"
+
+constexpr char PuzzleNoCenter = '\0';
+// the shortest word the NYT Spelling Bee accepts
+constexpr word_length_t PuzzleNytMinWordLength = 4;
+// the points the NYT Spelling Bee adds for a word that uses every letter
+constexpr unsigned PuzzleNytPangramBonus = 7;
+
+// the points the NYT Spelling Bee gives a word of 'length' letters, not
+//	counting the pangram bonus: 1 for the shortest words, else 1 per letter
+constexpr unsigned nytWordScore(word_length_t length) {
+	return length < PuzzleNytMinWordLength ? 0 :
+		   length == PuzzleNytMinWordLength ? 1 : length;
+}
+
+// One set of letters to search for
+//	Without a center letter, a word must use all of the letters and
+//	only those letters.  With one, a word may use any of the letters,
+//	and must use the center letter.  Words shorter than min_length,
+//	if it is not 0, are not answers
+struct Puzzle {
+	std::string letters;
+	char center;
+	letter_mask_t allowed;
+	letter_mask_t required;
+	word_length_t min_length;
+};
+
+// parses "abcdefg", or "abcdefg a" to give a center letter, ignoring
+//	spaces around them.  A puzzle with a center letter follows the NYT
+//	rules, see applyNytRules()
+//	returns false if either is not made of letters, if the center letter
+//	is not one of the letters, or if there are not between 'min_letters'
+//	and 'max_letters' distinct letters
+bool parsePuzzle(std::string_view line, int min_letters, int max_letters, Puzzle &puzzle);
+// the puzzle for all of the letters and only those letters
+Puzzle makePuzzle(std::string_view letters);
+// applies the rules of the NYT Spelling Bee to 'puzzle': the center letter
+//	is 'center', or if that is PuzzleNoCenter, the puzzle's own center
+//	letter, or else its first letter.  Words must use it, may use any of
+//	the other letters, and must be at least PuzzleNytMinWordLength long
+//	returns false, leaving the puzzle as it was, if 'center' is not one
+//	of the puzzle's letters
+bool applyNytRules(Puzzle &puzzle, char center);
+
+#endif /* PUZZLE_H_ */
@@ -0,0 +1,108 @@
+/*
+ * PuzzleExplorer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "PuzzleExplorer.h"
+
+#include <algorithm>
+
+void PuzzleExplorer::build(const LetterMaskIndex &index, const PangramIndex &pangrams) {
+
+	clear();
+
+	int num_letters = pangrams.numberOfLetters();
+
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		word_length_t length = index.length(i);
+		if ((mask & LetterMaskInvalid) || length < PuzzleNytMinWordLength ||
+			numberOfLetters(mask) > num_letters)
+			continue;
+		MaskTotals &totals = m_totals[mask];
+		totals.num_words++;
+		totals.score += nytWordScore(length);
+	}
+
+	m_letter_sets = pangrams.letterSets();
+}
+
+void PuzzleExplorer::clear(void) {
+
+	m_totals.clear();
+	m_letter_sets.clear();
+}
+
+void PuzzleExplorer::explore(size_t set, ExploredPuzzle *puzzles) const {
+
+	letter_mask_t letters = m_letter_sets[set];
+
+	// which of the puzzles each letter is the center of
+	int center_of[NumberOfLetters];
+	int num_centers = 0;
+	for (letter_mask_t bits = letters; bits != 0; bits &= bits - 1) {
+		int letter = __builtin_ctz(bits);
+		center_of[letter] = num_centers;
+		puzzles[num_centers++] = { letters, static_cast<char>('a' + letter), 0, 0, 0 };
+	}
+
+	for (letter_mask_t subset = letters; subset != 0; subset = (subset - 1) & letters) {
+		auto it = m_totals.find(subset);
+		if (it == m_totals.end())
+			continue;
+		for (letter_mask_t bits = subset; bits != 0; bits &= bits - 1) {
+			ExploredPuzzle &puzzle = puzzles[center_of[__builtin_ctz(bits)]];
+			puzzle.num_words += it->second.num_words;
+			puzzle.score += it->second.score;
+		}
+	}
+
+	// every pangram uses every letter, so it is an answer for every center
+	uint32_t num_pangrams = m_totals.at(letters).num_words;
+	for (int i = 0; i != num_centers; i++) {
+		puzzles[i].num_pangrams = num_pangrams;
+		puzzles[i].score += num_pangrams * PuzzleNytPangramBonus;
+	}
+}
+
+std::vector<ExploredPuzzle> PuzzleExplorer::explore(ThreadPool *pool) const {
+
+	size_t num_sets = m_letter_sets.size();
+	if (num_sets == 0)
+		return std::vector<ExploredPuzzle>();
+
+	// every set has the same number of letters, so each set's
+	//	puzzles have a place of their own that any thread can fill in
+	size_t puzzles_per_set = numberOfLetters(m_letter_sets[0]);
+	std::vector<ExploredPuzzle> puzzles(num_sets * puzzles_per_set);
+
+	size_t num_tasks = (num_sets + PuzzleExplorerSetsPerTask - 1) / PuzzleExplorerSetsPerTask;
+	auto explore_sets = [this, num_sets, puzzles_per_set, &puzzles](size_t task) {
+		size_t first = task * PuzzleExplorerSetsPerTask;
+		size_t last = std::min(first + PuzzleExplorerSetsPerTask, num_sets);
+		for (size_t set = first; set != last; set++) {
+			explore(set, &puzzles[set * puzzles_per_set]);
+		}
+	};
+	if (pool) {
+		pool->run(num_tasks, explore_sets);
+	} else {
+		for (size_t task = 0; task != num_tasks; task++) {
+			explore_sets(task);
+		}
+	}
+
+	auto better = [](const ExploredPuzzle &a, const ExploredPuzzle &b) {
+		if (a.score != b.score)
+			return a.score > b.score;
+		if (a.num_words != b.num_words)
+			return a.num_words > b.num_words;
+		if (a.letters != b.letters)
+			return a.letters < b.letters;
+		return a.center < b.center;
+	};
+	std::sort(puzzles.begin(), puzzles.end(), better);
+	return puzzles;
+}
@@ -0,0 +1,71 @@
+/*
+ * PuzzleExplorer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef PUZZLEEXPLORER_H_
+#define PUZZLEEXPLORER_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "LetterMask.h"
+#include "LetterMaskIndex.h"
+#include "PangramIndex.h"
+#include "Puzzle.h"
+#include "SpellingBeeSolver.h"
+#include "ThreadPool.h"
+
+// the number of letter sets each task of the thread pool explores
+constexpr size_t PuzzleExplorerSetsPerTask = 64;
+
+// One letter set and center letter, and what it would be worth as a puzzle
+struct ExploredPuzzle {
+	letter_mask_t letters;
+	char center;
+	uint32_t num_words;
+	uint32_t score;
+	uint32_t num_pangrams;
+};
+
+// Finds every NYT Spelling Bee puzzle a dictionary can make: every set of
+//	letters that some word uses all of, with each choice of center letter
+//
+//	The words are first added up by their distinct-letter mask, so a
+//	puzzle is explored by visiting the subsets of its letters once, and
+//	giving the totals of each subset to every center letter it contains,
+//	without looking at any of the words again
+class PuzzleExplorer {
+private:
+	struct MaskTotals {
+		uint32_t num_words;
+		uint32_t score;
+	};
+
+	std::unordered_map<letter_mask_t, MaskTotals> m_totals;
+	std::vector<letter_mask_t> m_letter_sets;
+
+	// fills in the puzzles of m_letter_sets[set], one per letter
+	void explore(size_t set, ExploredPuzzle *puzzles) const;
+
+public:
+	PuzzleExplorer() {}
+	virtual ~PuzzleExplorer() {}
+
+	// adds up the words of 'index' that the NYT rules accept, for
+	//	the sets of letters of 'pangrams', which must index 'index'
+	void build(const LetterMaskIndex &index, const PangramIndex &pangrams);
+	void clear(void);
+
+	size_t numberOfLetterSets(void) const	{ return m_letter_sets.size(); }
+
+	// explores every puzzle, splitting the letter sets across the threads
+	//	of 'pool', which may be nullptr, and returns them with the highest
+	//	scores first, then the most words, then by letter mask and center
+	std::vector<ExploredPuzzle> explore(ThreadPool *pool) const;
+};
+
+#endif /* PUZZLEEXPLORER_H_ */
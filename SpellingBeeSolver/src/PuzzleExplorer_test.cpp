@@ -0,0 +1,9 @@
+/*
+ * PuzzleExplorer_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "PuzzleExplorer.h"
+
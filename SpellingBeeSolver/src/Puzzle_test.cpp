@@ -0,0 +1,9 @@
+/*
+ * Puzzle_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "Puzzle.h"
+
@@ -0,0 +1,28 @@
+/*
+ * SearchEngine.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef SEARCHENGINE_H_
+#define SEARCHENGINE_H_
+
+#include <vector>
+
+#include "SpellingBeeSolver.h"
+
+// An index of the words of a LetterMaskIndex, laid out for searching
+//	Every engine finds the same words, so they can be swapped for each other
+class SearchEngine {
+public:
+	virtual ~SearchEngine() {}
+
+	// appends the id of every word that only uses letters in 'allowed'
+	//	and uses every letter in 'required' to 'matches', in dictionary order
+	//	returns the number of words appended
+	virtual size_t find(letter_mask_t allowed, letter_mask_t required,
+						std::vector<word_id_t> &matches) const = 0;
+};
+
+#endif /* SEARCHENGINE_H_ */
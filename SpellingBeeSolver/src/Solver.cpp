@@ -0,0 +1,92 @@
+/*
+ * Solver.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "Solver.h"
+
+#include <algorithm>
+
+Solver::Solver(const LetterMaskIndex &index, const SearchEngine *engine,
+			   const PangramIndex *pangrams, ThreadPool *thread_pool) :
+	m_index(index),
+	m_engine(engine),
+	m_pangrams(pangrams),
+	m_thread_pool(thread_pool) {}
+
+size_t Solver::find(letter_mask_t allowed, letter_mask_t required,
+					std::vector<word_id_t> &matches) {
+
+	// words that must use every letter and only those letters are pangrams
+	if (m_pangrams && allowed == required && (required & ~AllLettersMask) == 0 &&
+		numberOfLetters(required) == m_pangrams->numberOfLetters())
+		return m_pangrams->find(required, matches);
+
+	if (m_engine)
+		return m_engine->find(allowed, required, matches);
+
+	if (m_thread_pool) {
+		// the pool runs one job at a time
+		std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+		return m_index.find(allowed, required, matches, *m_thread_pool);
+	}
+
+	return m_index.find(allowed, required, matches);
+}
+
+size_t Solver::find(const Puzzle &puzzle, std::vector<word_id_t> &matches) {
+
+	size_t first = matches.size();
+	find(puzzle.allowed, puzzle.required, matches);
+	removeShortWords(puzzle.min_length, matches, first);
+	return matches.size() - first;
+}
+
+size_t Solver::findEveryCenter(const Puzzle &puzzle,
+							   std::vector<std::vector<word_id_t>> &matches) {
+
+	letter_mask_t allowed = puzzle.allowed & AllLettersMask;
+	matches.resize(NumberOfLetters);
+
+	size_t first_match[NumberOfLetters];
+	for (int letter = 0; letter != NumberOfLetters; letter++) {
+		first_match[letter] = matches[letter].size();
+	}
+
+	const MaskBucketIndex *buckets = dynamic_cast<const MaskBucketIndex *>(m_engine);
+	if (buckets) {
+		buckets->findEveryCenter(allowed, matches);
+	} else {
+		// one search for every word made of the letters, each of which
+		//	is then given to the letters it uses, in dictionary order
+		std::vector<word_id_t> words;
+		find(allowed, 0, words);
+		for (word_id_t id : words) {
+			for (letter_mask_t letters = m_index.mask(id); letters != 0; letters &= letters - 1) {
+				matches[__builtin_ctz(letters)].push_back(id);
+			}
+		}
+	}
+
+	size_t num_matches = 0;
+	for (int letter = 0; letter != NumberOfLetters; letter++) {
+		removeShortWords(puzzle.min_length, matches[letter], first_match[letter]);
+		num_matches += matches[letter].size() - first_match[letter];
+	}
+	return num_matches;
+}
+
+void Solver::removeShortWords(word_length_t min_length, std::vector<word_id_t> &matches,
+							  size_t first) const {
+
+	if (min_length <= 1)
+		return;
+
+	auto too_short = [this, min_length](word_id_t id) {
+		return m_index.length(id) < min_length;
+	};
+	matches.erase(std::remove_if(matches.begin() + first, matches.end(), too_short),
+				  matches.end());
+}
@@ -0,0 +1,71 @@
+/*
+ * Solver.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "LetterMaskIndex.h"
+#include "MaskBucketIndex.h"
+#include "PangramIndex.h"
+#include "Puzzle.h"
+#include "SearchEngine.h"
+#include "SpellingBeeSolver.h"
+#include "ThreadPool.h"
+
+// Answers searches against an index that has already been built, using
+//	the fastest structure it was given: the pangram index for words that
+//	use every letter, then the search engine if there is one, such as the
+//	bucket index, otherwise a parallel scan if there is a thread pool,
+//	otherwise a scan
+//
+//	find() may be called from many threads at once.  The indexes are only
+//	read, and searches that need the thread pool take turns using it
+class Solver {
+private:
+	const LetterMaskIndex &m_index;
+	const SearchEngine *m_engine;
+	const PangramIndex *m_pangrams;
+	ThreadPool *m_thread_pool;
+	std::mutex m_thread_pool_mutex;
+
+	// removes the words from matches[first] on that are shorter than 'min_length'
+	void removeShortWords(word_length_t min_length, std::vector<word_id_t> &matches,
+						  size_t first) const;
+
+public:
+	// 'engine', 'pangrams' and 'thread_pool' may be nullptr.  Everything
+	//	given must outlive the solver
+	Solver(const LetterMaskIndex &index, const SearchEngine *engine,
+		   const PangramIndex *pangrams, ThreadPool *thread_pool);
+	virtual ~Solver() {}
+
+	Solver(const Solver &other) = delete;
+	Solver& operator=(const Solver &other) = delete;
+
+	// appends the id of every word that only uses letters in 'allowed'
+	//	and uses every letter in 'required' to 'matches', in dictionary order
+	//	returns the number of words appended
+	size_t find(letter_mask_t allowed, letter_mask_t required,
+				std::vector<word_id_t> &matches);
+	// the same, for the letters of 'puzzle', leaving out words that
+	//	are shorter than its minimum length
+	size_t find(const Puzzle &puzzle, std::vector<word_id_t> &matches);
+	// finds the words of 'puzzle' for every choice of its center letter
+	//	in one search: matches[i] is given the words that use the letter i,
+	//	see MaskBucketIndex::findEveryCenter()
+	size_t findEveryCenter(const Puzzle &puzzle,
+						   std::vector<std::vector<word_id_t>> &matches);
+
+	const LetterMaskIndex &index(void) const	{ return m_index; }
+	std::string_view word(word_id_t id) const	{ return m_index.word(id); }
+};
+
+#endif /* SOLVER_H_ */
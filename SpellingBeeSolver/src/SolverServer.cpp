@@ -0,0 +1,250 @@
+/*
+ * SolverServer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "SolverServer.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Puzzle.h"
+
+// returns false if the connection closed or failed before 'size' bytes
+//	arrived, or if they had not all arrived by 'deadline'
+static bool receiveAll(int fd, void *data, size_t size,
+					   std::chrono::steady_clock::time_point deadline) {
+
+	char *bytes = static_cast<char *>(data);
+	while (size != 0) {
+		auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+				deadline - std::chrono::steady_clock::now());
+		if (remaining.count() <= 0)
+			return false;
+		struct pollfd readable = { fd, POLLIN, 0 };
+		int num_ready = poll(&readable, 1, static_cast<int>(remaining.count()));
+		if (num_ready < 0 && errno == EINTR)
+			continue;
+		if (num_ready <= 0)
+			return false;
+
+		ssize_t received = recv(fd, bytes, size, 0);
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received <= 0)
+			return false;
+		bytes += received;
+		size -= received;
+	}
+	return true;
+}
+
+// MSG_NOSIGNAL, so that a client that has gone away does not raise SIGPIPE
+static bool sendAll(int fd, const void *data, size_t size) {
+
+	const char *bytes = static_cast<const char *>(data);
+	while (size != 0) {
+		ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+			return false;
+		bytes += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+SolverServer::SolverServer(Solver &solver, int min_letters, int max_letters, bool nyt_rules) :
+	m_solver(solver),
+	m_min_letters(min_letters),
+	m_max_letters(max_letters),
+	m_nyt_rules(nyt_rules),
+	m_path(""),
+	m_listen_fd(-1),
+	m_num_active(0) {}
+
+SolverServer::~SolverServer() {
+
+	// m_listen_fd is only set once this server has bound the socket,
+	//	so a socket that belongs to another server is never removed
+	if (m_listen_fd >= 0) {
+		::close(m_listen_fd);
+		unlink(m_path.c_str());
+	}
+
+	// the clients' threads use this server, so they have to finish first.
+	//	Shutting their sockets down ends the receive each is waiting in
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (Client &client : m_clients) {
+			if (!client.done)
+				shutdown(client.fd, SHUT_RDWR);
+		}
+	}
+	for (Client &client : m_clients)
+		client.thread.join();
+}
+
+bool SolverServer::listen(const std::string &path) {
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (m_listen_fd >= 0 || path.empty() || path.size() >= sizeof(address.sun_path))
+		return false;
+	memcpy(address.sun_path, path.c_str(), path.size());
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return false;
+
+	// a socket left behind by a server that did not exit cleanly
+	//	would make bind() fail.  One that a server still answers on, or
+	//	anything else at 'path', is left alone
+	struct stat file_status;
+	if (lstat(path.c_str(), &file_status) == 0 && S_ISSOCK(file_status.st_mode)) {
+		if (connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0) {
+			::close(fd);
+			errno = EADDRINUSE;
+			return false;
+		}
+		unlink(path.c_str());
+	}
+
+	if (bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0) {
+		::close(fd);
+		return false;
+	}
+	if (::listen(fd, SolverServerBacklog) != 0) {
+		::close(fd);
+		unlink(path.c_str());
+		return false;
+	}
+
+	m_path = path;
+	m_listen_fd = fd;
+	return true;
+}
+
+bool SolverServer::serve(void) {
+
+	if (m_listen_fd < 0)
+		return false;
+
+	for (;;) {
+		// clients past the limit wait in the listen backlog
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_client_done.wait(lock, [this] { return m_num_active < SolverServerMaxClients; });
+		}
+		joinDoneClients();
+
+		int fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd < 0) {
+			// a client that disconnects while waiting is not an error
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			return false;
+		}
+
+		// a client that stops reading its answers is let go like an idle one
+		struct timeval send_timeout = { SolverServerIdleTimeoutSeconds, 0 };
+		setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_clients.push_back(Client { fd, false, std::thread() });
+		m_num_active++;
+		Client &client = m_clients.back();
+		client.thread = std::thread(&SolverServer::serveClient, this, std::ref(client));
+	}
+}
+
+void SolverServer::joinDoneClients(void) {
+
+	std::list<Client> done_clients;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto client = m_clients.begin(); client != m_clients.end(); ) {
+			auto next = std::next(client);
+			if (client->done)
+				done_clients.splice(done_clients.end(), m_clients, client);
+			client = next;
+		}
+	}
+	// each has at most to return from serveClient()
+	for (Client &client : done_clients)
+		client.thread.join();
+}
+
+void SolverServer::serveClient(Client &client) {
+
+	int fd = client.fd;
+	char request[SolverServerMaxRequestSize];
+	std::vector<word_id_t> matches;
+	std::string response;
+
+	for (;;) {
+		// the whole of the next request has to arrive in time, so that a
+		//	client sending a byte at a time cannot hold its place either
+		auto deadline = std::chrono::steady_clock::now() +
+						std::chrono::seconds(SolverServerIdleTimeoutSeconds);
+		uint32_t length;
+		if (!receiveAll(fd, &length, sizeof(length), deadline))
+			break;
+		length = ntohl(length);
+
+		bool too_long = length > SolverServerMaxRequestSize;
+		uint32_t status = SolverServerBadRequest;
+		matches.clear();
+		if (!too_long && receiveAll(fd, request, length, deadline)) {
+			Puzzle puzzle;
+			if (parsePuzzle(std::string_view(request, length),
+							m_min_letters, m_max_letters, puzzle)) {
+				if (m_nyt_rules && puzzle.center == PuzzleNoCenter)
+					applyNytRules(puzzle, PuzzleNoCenter);
+				m_solver.find(puzzle, matches);
+				status = SolverServerOk;
+			}
+		} else if (!too_long) {
+			break;
+		}
+
+		// the header is filled in once the length of the words is known
+		response.assign(2 * sizeof(uint32_t), '\0');
+		for (word_id_t id : matches) {
+			response += m_solver.word(id);
+			response += '\n';
+		}
+		uint32_t header[2] = {
+			htonl(status),
+			htonl(static_cast<uint32_t>(response.size() - sizeof(header)))
+		};
+		memcpy(&response[0], header, sizeof(header));
+
+		if (!sendAll(fd, response.data(), response.size()) || too_long)
+			break;
+	}
+
+	// closed while holding the lock, so that the destructor never shuts
+	//	down a descriptor that has been reused
+	std::lock_guard<std::mutex> lock(m_mutex);
+	::close(fd);
+	client.done = true;
+	m_num_active--;
+	m_client_done.notify_one();
+}
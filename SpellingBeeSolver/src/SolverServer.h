@@ -0,0 +1,101 @@
+/*
+ * SolverServer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef SOLVERSERVER_H_
+#define SOLVERSERVER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Solver.h"
+
+/*	Answers searches from other processes over a Unix domain socket
+ *
+ *	A client may send any number of requests on one connection, and
+ *	each is answered before the next is read.  All numbers are 32 bits,
+ *	most significant byte first
+ *		request		length, then 'length' bytes of a puzzle, as a --batch
+ *					line gives it: "abcdefg", or "abcdefg a" to give a
+ *					center letter
+ *		response	status, length, then 'length' bytes of the words
+ *					of the puzzle, in dictionary order, each followed by
+ *					a newline
+ *	Without a center letter, the words use all of the letters and only
+ *	those letters.  With one, or when the server follows the NYT rules,
+ *	they are those of applyNytRules(), the same as /solve over HTTP
+ *	A request that parsePuzzle() refuses is answered with
+ *	SolverServerBadRequest and no words.  A request longer than
+ *	SolverServerMaxRequestSize is answered the same way, and the
+ *	connection is then closed
+ *
+ *	Each client is answered on a thread of its own.  At most
+ *	SolverServerMaxClients are answered at once, the others wait to be
+ *	accepted until one of them disconnects.  A client is disconnected if
+ *	a whole request has not arrived SolverServerIdleTimeoutSeconds after
+ *	the last was answered, or if it does not read an answer for that
+ *	long, so clients that stay idle or stuck cannot hold every place
+ */
+
+constexpr uint32_t SolverServerOk = 0;
+constexpr uint32_t SolverServerBadRequest = 1;
+constexpr uint32_t SolverServerMaxRequestSize = 256;
+// connections waiting to be accepted
+constexpr int SolverServerBacklog = 128;
+constexpr size_t SolverServerMaxClients = 64;
+constexpr int SolverServerIdleTimeoutSeconds = 30;
+
+class SolverServer {
+private:
+	Solver &m_solver;
+	int m_min_letters;
+	int m_max_letters;
+	bool m_nyt_rules;
+	std::string m_path;
+	int m_listen_fd;
+
+	struct Client {
+		int fd;
+		// set, and 'fd' closed, once the client has been answered
+		bool done;
+		std::thread thread;
+	};
+	// guards m_clients and m_num_active, and every Client's fd and done
+	std::mutex m_mutex;
+	std::condition_variable m_client_done;
+	std::list<Client> m_clients;
+	size_t m_num_active;
+
+	SolverServer();
+	// answers requests on the client's fd until it disconnects
+	void serveClient(Client &client);
+	// joins the threads of the clients that are done
+	void joinDoneClients(void);
+
+public:
+	SolverServer(Solver &solver, int min_letters, int max_letters, bool nyt_rules);
+	// stops listening, disconnects the clients, waits for their threads,
+	//	and removes the socket if this server created it
+	virtual ~SolverServer();
+
+	SolverServer(const SolverServer &other) = delete;
+	SolverServer& operator=(const SolverServer &other) = delete;
+
+	// creates the socket at 'path', replacing a socket left there by an
+	//	earlier server that has exited.  Returns false if it cannot be
+	//	created, or if a server is still listening there
+	bool listen(const std::string &path);
+	// accepts clients until accepting fails, only returns on error
+	bool serve(void);
+
+	const std::string &path(void) const	{ return m_path; }
+};
+
+#endif /* SOLVERSERVER_H_ */
@@ -0,0 +1,9 @@
+/*
+ * Solver_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "Solver.h"
+
@@ -6,16 +6,39 @@
 // Description : Program to search for words that solve NYT Games Spelling Bee
 //============================================================================
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <vector>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <ctype.h>
+#include <errno.h>
+#include <string.h>
 
+#include "BitSlicedIndex.h"
+#include "CompiledDictionary.h"
+#include "DawgDictionary.h"
+#include "EmbeddedDictionary.h"
 #include "FileDictionary.h"
-#include "MemoryDictionary.h"
+#include "HttpServer.h"
+#include "IndexCache.h"
+#include "LetterMaskIndex.h"
+#include "MaskBucketIndex.h"
+#include "MmapDictionary.h"
+#include "MultiQueryScanner.h"
+#include "PangramIndex.h"
+#include "PostingListIndex.h"
+#include "Puzzle.h"
+#include "PuzzleExplorer.h"
+#include "Solver.h"
+#include "SolverServer.h"
+#include "SubsetCounts.h"
+#include "ThreadPool.h"
 
 #include "SpellingBeeSolver.h"
 
@@ -47,6 +70,8 @@
 #define MINIMUM_MAX_NUMBER_OF_LETTERS_TO_SEARCH_FOR 5
 #define GETLINE_TERMINATING_CHAR '\0'
 #define GET_LETTERS_FROM_CONSOLE_QUIT_CHAR '!'
+//    returned by getLettersFromConsole for '!' or the end of input
+#define GET_LETTERS_FROM_CONSOLE_QUIT -1
 #define DEFAULT_DICTIONARY_NAME                             "dictionary"
 #define DEFAULT_DICTIONARY_FILENAME_EXTENSION               ".txt"
 #define DEFAULT_DICTIONARY_INCLUDE_FILENAME_EXTENSION       ".h"
@@ -61,21 +86,111 @@
 "    by searching a user specified dictionary file.\n"\
 "    If no dictionary file is specified, an internal default dictionary is used\n"\
 "\n"\
-"  Usage: SpellingBeeSolver [-h] [-l \"abcdefg\"] [-f \"path/filename.ext\"]\n"\
+"  Usage: SpellingBeeSolver [-h] [-l \"abcdefg\"] [-f \"path/filename.ext\"] [-j N]\n"\
+"                           [-e buckets|postings|columns|dawg|scan]\n"\
+"                           [--nyt] [-c a] [--all-centers] [--hints] [--no-cache]\n"\
+"                           [--serve \"path/to.sock\"]\n"\
+"                           [--http 127.0.0.1:8080] [--batch \"path/puzzles.txt\"]\n"\
+"                           [--stream] [--rank N] [--explore \"path/report.txt\"]\n"\
+"                           [--benchmark N]\n"\
+"         SpellingBeeSolver --compile-dict \"path/in.txt\" \"path/out.sbd\"\n"\
 "    -h prints this help string\n"\
 "    -l uses a quote enclosed list of letters as search terms\n"\
-"    -f specifies the path and filename to the dictionary\n"
+"       Without -l, letters are read from the console, one search per line,\n"\
+"       until ! is entered\n"\
+"    -f specifies the path and filename to the dictionary, either a text file\n"\
+"       with one word per line or a dictionary compiled with --compile-dict\n"\
+"       The index of a text dictionary is cached in $XDG_CACHE_HOME\n"\
+"       so that later runs against the same file start faster\n"\
+"    --nyt follows the rules of the NYT Spelling Bee: every word uses the\n"\
+"       center letter, may use any of the other letters, and has at least\n"\
+"       " << PuzzleNytMinWordLength << " letters.  The center letter is the first letter entered,\n"\
+"       or the first letter of each --batch line, --serve or --http search\n"\
+"       that does not give one.  A puzzle that gives one always follows them\n"\
+"    -c gives the center letter for --nyt, and implies --nyt.  It must be\n"\
+"       one of the letters, and cannot be used with --batch, --serve or --http\n"\
+"    --all-centers finds the words for every choice of center letter\n"\
+"       at once, and implies --nyt.  It cannot be used with --serve or --http\n"\
+"    --hints also counts the words that start with each pair of letters,\n"\
+"       the way the NYT gives hints.  It implies --nyt and -e dawg\n"\
+"    -j scans the whole dictionary using N threads (0 = one per CPU)\n"\
+"       instead of looking the letters up in an index\n"\
+"    -e chooses how searches are answered: by looking up the subsets of the\n"\
+"       letters (buckets, the default), by combining a list of the words\n"\
+"       that use each letter (postings), by combining a bit for every word\n"\
+"       for each letter (columns), by walking a compressed tree of the\n"\
+"       words (dawg), or by scanning every word (scan, the default with -j)\n"\
+"       dawg numbers the words in sorted order, and lists each word once\n"\
+"    --no-cache neither reads nor writes the cached index of the dictionary\n"\
+"    --serve loads the dictionary once, then answers searches sent to\n"\
+"       a Unix domain socket at the given path until it is killed.\n"\
+"       Each search is a line of --batch, see SolverServer.h\n"\
+"    --http loads the dictionary once, then answers\n"\
+"       GET /solve?letters=abcdefg&center=a with a JSON array of words\n"\
+"    --batch solves every puzzle in a file, or standard input if it is -\n"\
+"       one puzzle per line: the letters, then optionally a center letter\n"\
+"       from among them that every word must use, under the NYT rules,\n"\
+"       i.e. \"abcdefg a\"\n"\
+"    --stream solves a batch in a single pass over the dictionary without\n"\
+"       indexing it.  This is always done for a dictionary that cannot be\n"\
+"       memory mapped, such as a pipe\n"\
+"    --rank counts the words of at least " << PuzzleNytMinWordLength << " letters that can be made from\n"\
+"       every set of " << MAX_NUMBER_OF_LETTERS << " letters and use its center letter, trying each\n"\
+"       of the letters as the center, and prints the N puzzles with the most\n"\
+"    --explore scores every puzzle the dictionary can make: every set of\n"\
+"       " << MAX_NUMBER_OF_LETTERS << " letters that some word uses all of, with each center letter\n"\
+"       and writes them, best first, to a file, or standard output if it is -\n"\
+"    --benchmark times N searches of puzzles the dictionary can make\n"\
+"       with every search engine, and prints the time each search took\n"\
+"    --compile-dict compiles a text dictionary into a file that loads without being parsed\n"
 
 #define HELP_TOKEN    'h'
 #define LETTERS_TOKEN 'l'
 #define FILENAME_TOKEN 'f'
+#define THREADS_TOKEN 'j'
+#define CENTER_TOKEN 'c'
+#define ENGINE_TOKEN 'e'
+#define LONG_OPTION_TOKEN '-'
+#define COMPILE_DICTIONARY_OPTION "--compile-dict"
+#define NO_CACHE_OPTION "--no-cache"
+#define NYT_RULES_OPTION "--nyt"
+#define ALL_CENTERS_OPTION "--all-centers"
+#define HINTS_OPTION "--hints"
+#define SERVE_OPTION "--serve"
+#define HTTP_OPTION "--http"
+#define BATCH_OPTION "--batch"
+#define BATCH_FROM_STANDARD_INPUT "-"
+#define STREAM_OPTION "--stream"
+#define RANK_OPTION "--rank"
+#define EXPLORE_OPTION "--explore"
+#define EXPLORE_TO_STANDARD_OUTPUT "-"
+#define BENCHMARK_OPTION "--benchmark"
+#define BATCH_COMMENT_CHAR '#'
+#define BUCKETS_ENGINE "buckets"
+#define POSTINGS_ENGINE "postings"
+#define COLUMNS_ENGINE "columns"
+#define DAWG_ENGINE "dawg"
+#define SCAN_ENGINE "scan"
 
 #define USE_CONSOLE_FOR_LETTERS    -1
 #define USE_DEFAULT_DICTIONARY    -1
+#define USE_INDEXED_SEARCH        -1
+#define NOT_COMPILING_DICTIONARY  -1
+#define NOT_SERVING               -1
+#define NOT_BATCH                 -1
+#define USE_FIRST_LETTER_AS_CENTER -1
+#define NOT_RANKING               -1
+#define NOT_EXPLORING             -1
+#define USE_DEFAULT_ENGINE        -1
+#define NOT_BENCHMARKING          -1
 
 #define FILE_INPUT_CHAR_ARRAY_LENGTH    128
 
+//    may be given as 0 on the command line, -DCOMPILE_DEFAULT_DICTIONARY=0,
+//      for a compiler whose constexpr limits the default dictionary exceeds
+#ifndef COMPILE_DEFAULT_DICTIONARY
 #define COMPILE_DEFAULT_DICTIONARY 1
+#endif
 
 
 /*    **********************************************************************    */
@@ -84,6 +199,29 @@
 /*    **********************************************************************    */
 /*    **********************************************************************    */
 
+//    the position in argv of the argument following each switch,
+//      or USE_... / NOT_... if the switch was not given
+struct CommandLineArguments {
+    int letters_arg_position;
+    int filename_arg_position;
+    int threads_arg_position;
+    //    the output filename follows the input filename
+    int compile_arg_position;
+    int serve_arg_position;
+    int http_arg_position;
+    int batch_arg_position;
+    int center_arg_position;
+    int rank_arg_position;
+    int explore_arg_position;
+    int engine_arg_position;
+    int benchmark_arg_position;
+    bool use_index_cache;
+    bool stream_batch;
+    bool nyt_rules;
+    bool all_centers;
+    bool hints;
+};
+
 
 /*    **********************************************************************    */
 /*    **********************************************************************    */
@@ -94,11 +232,25 @@
 #if COMPILE_DEFAULT_DICTIONARY == 1
 #include "dictionary_array.h"
 #else
-static word_t default_word_list[] = {
-        "DEFAULT", "DICTIONARY", "NOT",
-        "COMPILED", "IN", "THIS", "BUILD" };
+static constexpr char default_word_blob[] =
+        "DEFAULT\n" "DICTIONARY\n" "NOT\n"
+        "COMPILED\n" "IN\n" "THIS\n" "BUILD\n";
 #endif
 
+//    the offset table, and the length and letter mask of every word
+//      are computed by the compiler from the blob, so the default
+//      dictionary's LetterMaskIndex needs no building at run time
+//      GCC's default constexpr limits allow this, other compilers need
+//      theirs raised, see EmbeddedDictionary.h
+static constexpr dictionary_size_t default_dictionary_size =
+        embeddedWordCount(default_word_blob);
+static constexpr auto default_word_offsets =
+        embeddedWordOffsets<default_dictionary_size>(default_word_blob);
+static constexpr auto default_word_lengths =
+        embeddedWordLengths<default_dictionary_size>(default_word_blob);
+static constexpr auto default_word_masks =
+        embeddedWordMasks<default_dictionary_size>(default_word_blob);
+
 struct DictionaryStruct {
     word_t *word_list;
     dictionary_size_t size;
@@ -111,13 +263,30 @@ struct DictionaryStruct {
 /*    **********************************************************************    */
 /*    **********************************************************************    */
 
-bool ensureAllLettersAreInWord(letters_t &letters, word_t &word);
-bool ensureWordOnlyUsesLetters(letters_t &letters, word_t &word);
+int benchmarkEngines(const LetterMaskIndex &index, const PangramIndex &pangrams,
+                     const DawgDictionary *dawg, size_t num_searches);
+int compileDictionary(const std::string &input_filename, const std::string &output_filename);
+int explorePuzzles(const LetterMaskIndex &index, const PangramIndex &pangrams,
+                   ThreadPool *thread_pool, const std::string &filename);
 int getLettersFromToken(letters_t &letters, char *cmd_line_token, unsigned max_number_of_letters);
 int getLettersFromConsole(letters_t &letters, unsigned max_number_of_letters);
-void parseCommandLine(int &letters_arg_position, int &filename_arg_position, int argc, char **argv);
-void printDictionary(std::unique_ptr<Dictionary> &dictionary, int num_words_at_start);
+std::unique_ptr<Dictionary> openDictionaryFile(const std::string &filename);
+void parseCommandLine(CommandLineArguments &arguments, int argc, char **argv);
+void printDictionary(const LetterMaskIndex &index, int num_words_at_start);
+void printEveryCenterMatches(const LetterMaskIndex &words, const Puzzle &puzzle, size_t puzzle_number,
+                             const std::vector<std::vector<word_id_t>> &matches);
+void printHints(const DawgDictionary &dawg, const Puzzle &puzzle);
+void printPuzzleMatches(const LetterMaskIndex &words, const Puzzle &puzzle, size_t puzzle_number,
+                        const std::vector<word_id_t> &matches);
+int rankLetterSets(const LetterMaskIndex &index, ThreadPool *thread_pool, size_t num_sets);
+bool readPuzzleFile(const std::string &filename, std::vector<Puzzle> &puzzles);
+void readPuzzles(std::istream &input, std::vector<Puzzle> &puzzles);
 void removeDuplicateLetters(letters_t &letters);
+void searchForLetters(Solver &solver, letters_t &letters, size_t minimum_number_of_letters,
+                      bool nyt_rules, char center, bool all_centers, const DawgDictionary *hints);
+int scanBatch(Dictionary &dictionary, const std::string &filename, bool nyt_rules,
+              bool all_centers);
+int solveBatch(Solver &solver, const std::string &filename, bool nyt_rules, bool all_centers);
 
 
 /*    **********************************************************************    */
@@ -142,28 +311,74 @@ int main(int argc, char **argv) {
             MINIMUM_MAX_NUMBER_OF_LETTERS_TO_SEARCH_FOR;
 
     letters_t letters;
-    dictionary_size_t default_dictionary_size =
-            static_cast<long>(sizeof(default_word_list)/sizeof(word_t));
-
-    std::unique_ptr<FileDictionary> imported_dictionary;
-    std::unique_ptr<Dictionary> dictionary = std::make_unique<MemoryDictionary>(default_word_list, default_dictionary_size);
+    LetterMaskIndex index;
+    MaskBucketIndex buckets;
+    PostingListIndex postings;
+    BitSlicedIndex columns;
+    PangramIndex pangrams;
+
+    bool using_default_dictionary = true;
+    std::unique_ptr<IndexCache> index_cache;
+    std::unique_ptr<Dictionary> imported_dictionary;
+    std::unique_ptr<Dictionary> dictionary =
+            std::make_unique<EmbeddedDictionary>(default_word_blob,
+                                                 default_word_offsets.data(),
+                                                 default_dictionary_size);
 
     //    attempt to open a dictionary file if provided
     std::string filename("");
-    std::string letters_str("");
 
-    int letters_arg_position = USE_CONSOLE_FOR_LETTERS;
-    int filename_arg_position = USE_DEFAULT_DICTIONARY;
+    CommandLineArguments arguments;
+    parseCommandLine(arguments, argc, argv);
+
+    if (arguments.compile_arg_position != NOT_COMPILING_DICTIONARY) {
+        return compileDictionary(argv[arguments.compile_arg_position],
+                                 argv[arguments.compile_arg_position+1]);
+    }
+
+    //    each puzzle of a batch or a server gives its own center letter,
+    //      and a server answers one center letter at a time
+    bool serving = arguments.serve_arg_position != NOT_SERVING ||
+                   arguments.http_arg_position != NOT_SERVING;
+    if (arguments.center_arg_position != USE_FIRST_LETTER_AS_CENTER &&
+        (serving || arguments.batch_arg_position != NOT_BATCH)) {
+        std::cout << "-c cannot be used with --batch, --serve or --http, "
+                  << "each of their puzzles gives its own center letter" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (arguments.all_centers && serving) {
+        std::cout << ALL_CENTERS_OPTION << " cannot be used with --serve or --http" << std::endl;
+        return EXIT_FAILURE;
+    }
 
-    parseCommandLine(letters_arg_position, filename_arg_position, argc, argv);
+    //    the parallel scan does not need the bucket index
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (arguments.threads_arg_position != USE_INDEXED_SEARCH) {
+        int num_threads = std::max(0, atoi(argv[arguments.threads_arg_position]));
+        thread_pool = std::make_unique<ThreadPool>(num_threads);
+        std::cout << "Scanning the dictionary with "
+                  << thread_pool->size() << " threads" << std::endl;
+    }
 
-    if (filename_arg_position != USE_DEFAULT_DICTIONARY) {
+    if (arguments.filename_arg_position != USE_DEFAULT_DICTIONARY) {
         filename.clear();
-        filename += argv[filename_arg_position];
-        imported_dictionary = std::make_unique<FileDictionary>(filename);
+        filename += argv[arguments.filename_arg_position];
+        imported_dictionary = openDictionaryFile(filename);
+        //    a text dictionary that has been indexed before is replaced by its index
+        if (!imported_dictionary->isError() && arguments.use_index_cache &&
+            !dynamic_cast<CompiledDictionary *>(imported_dictionary.get())) {
+            index_cache = std::make_unique<IndexCache>(filename);
+            std::unique_ptr<CompiledDictionary> cached_dictionary = index_cache->load();
+            if (cached_dictionary) {
+                std::cout << "Using cached index " << index_cache->cacheFilename() << std::endl;
+                imported_dictionary = std::move(cached_dictionary);
+                index_cache.reset();
+            }
+        }
         if (!imported_dictionary->isError()) {
             std::cout << "Opened dictionary file " << filename << std::endl;
             dictionary = std::move(imported_dictionary);
+            using_default_dictionary = false;
         } else {
             std::cout << "Unable to load dictionary from file " << filename
                       << std::endl
@@ -175,48 +390,180 @@ int main(int argc, char **argv) {
 
     std::cout << std::endl;
     dictionary->open();
-    printDictionary(dictionary, num_words_printed_from_start_of_dictionary);
-    dictionary->begining();
 
-    if (letters_arg_position == USE_CONSOLE_FOR_LETTERS) {
-        getLettersFromConsole(letters, MAX_NUMBER_OF_LETTERS);
+    //    a batch against a dictionary that can only be read a line at a time
+    //      is answered by reading it once, rather than by indexing it.
+    //      The first words are not printed, that would read them twice
+    if (arguments.batch_arg_position != NOT_BATCH &&
+        (arguments.stream_batch || dynamic_cast<FileDictionary *>(dictionary.get()))) {
+        return scanBatch(*dictionary, argv[arguments.batch_arg_position], arguments.nyt_rules,
+                         arguments.all_centers);
+    }
+
+    //    a server answers many searches, so the buckets are worth building
+    std::string engine_name = thread_pool && !serving ? SCAN_ENGINE : BUCKETS_ENGINE;
+    if (arguments.hints) {
+        engine_name = DAWG_ENGINE;
+    }
+    if (arguments.engine_arg_position != USE_DEFAULT_ENGINE) {
+        engine_name = argv[arguments.engine_arg_position];
+    }
+    if (arguments.hints && engine_name != DAWG_ENGINE) {
+        std::cout << "Hints are counted with the " << DAWG_ENGINE << " engine, not "
+                  << engine_name << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //    the words of a DAWG are numbered in sorted order, so the DAWG
+    //      replaces the dictionary, and the index is built from it
+    DawgDictionary *dawg = nullptr;
+    if (engine_name == DAWG_ENGINE) {
+        std::unique_ptr<DawgDictionary> dawg_dictionary = std::make_unique<DawgDictionary>();
+        if (!dawg_dictionary->build(*dictionary) || !dawg_dictionary->open()) {
+            std::cout << "Unable to compile the dictionary into a DAWG" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Compiled " << dawg_dictionary->size() << " words into a DAWG of "
+                  << dawg_dictionary->numberOfNodes() << " nodes and "
+                  << dawg_dictionary->numberOfEdges() << " edges, "
+                  << dawg_dictionary->memoryUsed() << " bytes" << std::endl;
+        dawg = dawg_dictionary.get();
+        dictionary = std::move(dawg_dictionary);
+        using_default_dictionary = false;
+        //    the cached index would be in the order of the dictionary file
+        index_cache.reset();
+    }
+
+    //    the letter masks of every word are computed once, here,
+    //      so that searching does not need to look at the words again
+    CompiledDictionary *compiled_dictionary = dynamic_cast<CompiledDictionary *>(dictionary.get());
+    if (using_default_dictionary) {
+        index.attach(std::string_view(default_word_blob, sizeof(default_word_blob)-1),
+                     default_word_offsets.data(), default_word_lengths.data(),
+                     default_word_masks.data(), default_dictionary_size);
+    } else if (compiled_dictionary) {
+        //    a compiled dictionary is its own index
+        compiled_dictionary->attachIndex(index);
     } else {
-        getLettersFromToken(letters, argv[letters_arg_position], MAX_NUMBER_OF_LETTERS);
+        //    a mapped file is split on line boundaries across the threads
+        MmapDictionary *mapped_dictionary = dynamic_cast<MmapDictionary *>(dictionary.get());
+        bool is_indexed;
+        if (thread_pool && mapped_dictionary) {
+            is_indexed = index.build(mapped_dictionary->contents(), *thread_pool);
+        } else {
+            is_indexed = index.build(*dictionary);
+        }
+        if (!is_indexed) {
+            std::cout << "Unable to index dictionary " << filename << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (index_cache && index_cache->save(index)) {
+            std::cout << "Saved index to " << index_cache->cacheFilename() << std::endl;
+        }
     }
+    //    the first words are printed from the index, since a dictionary
+    //      such as a pipe can only be read once, to build it
+    printDictionary(index, num_words_printed_from_start_of_dictionary);
 
-    removeDuplicateLetters(letters);
-    letters_str += '"';
-    for (size_t i = 0; i != letters.size(); i++) {
-        letters_str += letters[i];
+    //    the words that use every letter of a puzzle are looked up on their own
+    pangrams.build(index, MAX_NUMBER_OF_LETTERS);
+
+    if (arguments.explore_arg_position != NOT_EXPLORING) {
+        return explorePuzzles(index, pangrams, thread_pool.get(),
+                              argv[arguments.explore_arg_position]);
+    }
+    if (arguments.rank_arg_position != NOT_RANKING) {
+        return rankLetterSets(index, thread_pool.get(),
+                              std::max(0, atoi(argv[arguments.rank_arg_position])));
+    }
+    if (arguments.benchmark_arg_position != NOT_BENCHMARKING) {
+        return benchmarkEngines(index, pangrams, dawg,
+                                std::max(0, atoi(argv[arguments.benchmark_arg_position])));
     }
-    letters_str += '"';
 
-    if (letters.size() >= minimum_number_of_letters_to_search_for) {
-        std::cout << "Searching for words that contain all of these and only these letters:    "
-               << letters_str << std::endl << std::endl;
-        int success_count = 0;
+    SearchEngine *engine = nullptr;
+    if (engine_name == BUCKETS_ENGINE) {
+        buckets.build(index);
+        engine = &buckets;
+    } else if (engine_name == POSTINGS_ENGINE) {
+        postings.build(index);
+        engine = &postings;
+        std::cout << "Built posting lists of " << postings.memoryUsed() << " bytes" << std::endl;
+    } else if (engine_name == COLUMNS_ENGINE) {
+        columns.build(index);
+        engine = &columns;
+        std::cout << "Built letter columns of " << columns.memoryUsed() << " bytes" << std::endl;
+    } else if (engine_name == DAWG_ENGINE) {
+        engine = dawg;
+    } else if (engine_name != SCAN_ENGINE) {
+        std::cout << "Unknown search engine \"" << engine_name << "\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+    Solver solver(index, engine, &pangrams, thread_pool.get());
+    const DawgDictionary *hints = arguments.hints ? dawg : nullptr;
 
-        while (dictionary->isNext()) {
-            std::string word = dictionary->nextWord();
-            if (ensureAllLettersAreInWord(letters, word) &&
-                ensureWordOnlyUsesLetters(letters, word)) {
+    if (arguments.batch_arg_position != NOT_BATCH) {
+        return solveBatch(solver, argv[arguments.batch_arg_position], arguments.nyt_rules,
+                          arguments.all_centers);
+    }
+    if (arguments.http_arg_position != NOT_SERVING) {
+        HttpServer server(solver, MINIMUM_MAX_NUMBER_OF_LETTERS_TO_SEARCH_FOR,
+                          MAX_NUMBER_OF_LETTERS, arguments.nyt_rules);
+        if (!server.listen(argv[arguments.http_arg_position])) {
+            std::cout << "Unable to listen on " << argv[arguments.http_arg_position]
+                      << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << std::endl << "Serving HTTP on " << argv[arguments.http_arg_position] << std::endl;
+        server.serve();
+        std::cout << "Stopped serving: " << strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (arguments.serve_arg_position != NOT_SERVING) {
+        SolverServer server(solver, MINIMUM_MAX_NUMBER_OF_LETTERS_TO_SEARCH_FOR,
+                            MAX_NUMBER_OF_LETTERS, arguments.nyt_rules);
+        if (!server.listen(argv[arguments.serve_arg_position])) {
+            std::cout << "Unable to listen on " << argv[arguments.serve_arg_position]
+                      << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << std::endl << "Serving searches on " << server.path() << std::endl;
+        server.serve();
+        std::cout << "Stopped serving: " << strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
 
-                std::cout << std::setw(WORD_NUMBER_PRINTED_WIDTH)
-                          << ++success_count << ": "
-                          << letters_str << "   found in word   " << word << std::endl;
-            }
+    char center = PuzzleNoCenter;
+    if (arguments.center_arg_position != USE_FIRST_LETTER_AS_CENTER) {
+        center = argv[arguments.center_arg_position][0];
+        if (letterBit(center) == LetterMaskInvalid ||
+            argv[arguments.center_arg_position][1] != '\0') {
+            std::cout << "The center letter must be a single letter, not \""
+                      << argv[arguments.center_arg_position] << "\"" << std::endl;
+            return EXIT_FAILURE;
         }
-        if (success_count == 0) {
-            std::cout << "No qualifying words found the dictionary" << std::endl;
+        if (arguments.letters_arg_position != USE_CONSOLE_FOR_LETTERS &&
+            (letterMask(argv[arguments.letters_arg_position]) & letterBit(center)) == 0) {
+            std::cout << "The center letter must be one of the puzzle letters, not "
+                      << center << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (arguments.letters_arg_position == USE_CONSOLE_FOR_LETTERS) {
+        //    the dictionary stays loaded and indexed between entries,
+        //      so only the first entry waits for it
+        while (getLettersFromConsole(letters, MAX_NUMBER_OF_LETTERS) !=
+               GET_LETTERS_FROM_CONSOLE_QUIT) {
+            searchForLetters(solver, letters, minimum_number_of_letters_to_search_for,
+                             arguments.nyt_rules, center, arguments.all_centers, hints);
+            std::cout << std::endl;
         }
     } else {
-        // there were an insufficient number of letters to search for, but not == 0 which means quit
-        if (letters.size() > 0) {
-            std::cout << "Error: Only " << letters.size()
-                      << " letters will result in too many matches." << std::endl
-                      << "       Not performing search" << std::endl;
-        }   
-    } 
+        getLettersFromToken(letters, argv[arguments.letters_arg_position], MAX_NUMBER_OF_LETTERS);
+        searchForLetters(solver, letters, minimum_number_of_letters_to_search_for,
+                         arguments.nyt_rules, center, arguments.all_centers, hints);
+    }
 
     std::cout << std::endl << "SpellingBeeSolver completed" << std::endl;
     return EXIT_SUCCESS;
@@ -229,36 +576,184 @@ int main(int argc, char **argv) {
 /*    **********************************************************************    */
 /*    **********************************************************************    */
 
-bool ensureAllLettersAreInWord(letters_t &letters, word_t &word) {
+int benchmarkEngines(const LetterMaskIndex &index, const PangramIndex &pangrams,
+                     const DawgDictionary *dawg, size_t num_searches) {
 
-    std::string lower_case("");
+    typedef std::chrono::steady_clock clock;
 
-    for (size_t i = 0; i != word.size(); i++) {
-        lower_case += tolower(word[i]);
+    //    the puzzles are spread across every set of letters some word uses all of
+    const std::vector<letter_mask_t> &letter_sets = pangrams.letterSets();
+    if (letter_sets.empty() || num_searches == 0) {
+        std::cout << "The dictionary makes no puzzles to search for" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<letter_mask_t> puzzles(num_searches);
+    for (size_t i = 0; i != num_searches; i++) {
+        puzzles[i] = letter_sets[(i * letter_sets.size()) / num_searches];
+    }
+
+    //    every shape of search is asked of every engine
+    struct SearchShape {
+        const char *name;
+        //    the letters of a puzzle that every word must use
+        letter_mask_t (*required)(letter_mask_t letters, size_t search);
+    };
+    const SearchShape shapes[] = {
+        { "center", [](letter_mask_t letters, size_t search) {
+            //    each letter of the puzzle takes a turn as the center
+            for (size_t i = search % numberOfLetters(letters); i != 0; i--) {
+                letters &= letters - 1;
+            }
+            return letters & -letters;
+        } },
+        { "any", [](letter_mask_t, size_t) { return letter_mask_t(0); } },
+        { "pangram", [](letter_mask_t letters, size_t) { return letters; } },
+    };
+
+    MaskBucketIndex buckets;
+    PostingListIndex postings;
+    BitSlicedIndex columns;
+    struct BenchmarkedEngine {
+        const char *name;
+        const SearchEngine *engine;
+        std::function<void(void)> build;
+        std::function<size_t(void)> memory_used;
+    };
+    std::vector<BenchmarkedEngine> engines = {
+        { SCAN_ENGINE, nullptr, [](){},
+          [&index](){ return index.size() * sizeof(letter_mask_t); } },
+        { BUCKETS_ENGINE, &buckets, [&](){ buckets.build(index); },
+          [&buckets](){ return buckets.size() * sizeof(word_id_t) +
+                               buckets.numberOfBuckets() * 2 * sizeof(uint32_t); } },
+        { POSTINGS_ENGINE, &postings, [&](){ postings.build(index); },
+          [&postings](){ return postings.memoryUsed(); } },
+        { COLUMNS_ENGINE, &columns, [&](){ columns.build(index); },
+          [&columns](){ return columns.memoryUsed(); } },
+    };
+    //    a DAWG can only search an index that was built from it,
+    //      so it is timed only if it was, and its build is not
+    if (dawg) {
+        engines.push_back({ DAWG_ENGINE, dawg, [](){},
+                            [dawg](){ return dawg->memoryUsed(); } });
     }
 
-    for (char letter : letters) {
-        if (lower_case.find(tolower(letter)) == std::string::npos) {
-            return false;
+    std::cout << "Timing " << num_searches << " searches of each shape against "
+              << index.size() << " words" << std::endl << std::endl;
+    std::cout << std::setw(10) << "engine" << std::setw(12) << "build ms"
+              << std::setw(12) << "bytes";
+    for (const SearchShape &shape : shapes) {
+        std::cout << std::setw(12) << std::string(shape.name) + " us";
+    }
+    std::cout << std::setw(12) << "matches" << '\n';
+
+    std::ios_base::fmtflags flags = std::cout.flags();
+    std::cout << std::fixed << std::setprecision(1);
+    std::vector<word_id_t> matches;
+    for (const BenchmarkedEngine &benchmarked : engines) {
+        clock::time_point start = clock::now();
+        benchmarked.build();
+        std::chrono::duration<double, std::milli> build_time = clock::now() - start;
+        std::cout << std::setw(10) << benchmarked.name << std::setw(12) << build_time.count()
+                  << std::setw(12) << benchmarked.memory_used();
+
+        //    no pangram index, so that every search is answered by the engine
+        Solver solver(index, benchmarked.engine, nullptr, nullptr);
+        size_t num_matches = 0;
+        for (const SearchShape &shape : shapes) {
+            start = clock::now();
+            for (size_t i = 0; i != num_searches; i++) {
+                matches.clear();
+                num_matches += solver.find(puzzles[i], shape.required(puzzles[i], i), matches);
+            }
+            std::chrono::duration<double, std::micro> search_time = clock::now() - start;
+            std::cout << std::setw(12) << search_time.count() / num_searches;
         }
+        //    the same for every engine
+        std::cout << std::setw(12) << num_matches << std::endl;
     }
-    return true;
+    std::cout.flags(flags);
+
+    std::cout << std::endl << "SpellingBeeSolver completed" << std::endl;
+    return EXIT_SUCCESS;
 }
 
 
-bool ensureWordOnlyUsesLetters(letters_t &letters, word_t &word) {
-    for (char word_letter : word) {
-        bool letter_in_word_is_not_in_input = true;
-        for (char input_letter : letters) {
-            if (tolower(word_letter) == tolower(input_letter)) {
-                letter_in_word_is_not_in_input = false;
-                break;
-            }
+int compileDictionary(const std::string &input_filename, const std::string &output_filename) {
+
+    LetterMaskIndex index;
+    CompiledDictionarySource source;
+
+    std::unique_ptr<Dictionary> dictionary = openDictionaryFile(input_filename);
+    if (dictionary->isError() || !CompiledDictionary::describeSource(input_filename, source)) {
+        std::cout << "Unable to load dictionary from file " << input_filename << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!index.build(*dictionary)) {
+        std::cout << "Unable to index dictionary " << input_filename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!CompiledDictionary::write(index, source, output_filename)) {
+        std::cout << "Unable to write compiled dictionary " << output_filename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //    read back what was written
+    CompiledDictionary compiled(output_filename);
+    if (compiled.isError() || !compiled.verify() || compiled.size() != index.size()) {
+        std::cout << "Compiled dictionary " << output_filename
+                  << " failed verification: " << toString(compiled.getState()) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Compiled " << index.size() << " words from " << input_filename
+              << " into " << output_filename << std::endl;
+    return EXIT_SUCCESS;
+}
+
+
+int explorePuzzles(const LetterMaskIndex &index, const PangramIndex &pangrams,
+                   ThreadPool *thread_pool, const std::string &filename) {
+
+    std::ofstream report_file;
+    if (filename != EXPLORE_TO_STANDARD_OUTPUT) {
+        report_file.open(filename);
+        if (!report_file) {
+            std::cout << "Unable to open " << filename << " for writing" << std::endl;
+            return EXIT_FAILURE;
         }
-        if (letter_in_word_is_not_in_input)
-            return false;
     }
-    return true;
+    std::ostream &report = report_file.is_open() ? report_file : std::cout;
+
+    //    without -j, every CPU is used to explore
+    std::unique_ptr<ThreadPool> own_thread_pool;
+    if (!thread_pool) {
+        own_thread_pool = std::make_unique<ThreadPool>(0);
+        thread_pool = own_thread_pool.get();
+    }
+
+    PuzzleExplorer explorer;
+    explorer.build(index, pangrams);
+    std::vector<ExploredPuzzle> puzzles = explorer.explore(thread_pool);
+    std::cout << "Explored " << puzzles.size() << " puzzles made from "
+              << explorer.numberOfLetterSets() << " sets of " << MAX_NUMBER_OF_LETTERS
+              << " letters" << std::endl << std::endl;
+
+    //    the first two columns can be given to --batch
+    report << BATCH_COMMENT_CHAR << " letters\tcenter\twords\tscore\tpangrams\n";
+    for (const ExploredPuzzle &puzzle : puzzles) {
+        report << letterString(puzzle.letters) << '\t' << puzzle.center << '\t'
+               << puzzle.num_words << '\t' << puzzle.score << '\t'
+               << puzzle.num_pangrams << '\n';
+    }
+    report.flush();
+    if (!report) {
+        std::cout << "Error writing the report to " << filename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::endl << "SpellingBeeSolver completed" << std::endl;
+    return EXIT_SUCCESS;
 }
 
 
@@ -309,13 +804,23 @@ int getLettersFromConsole(letters_t &letters, unsigned max_number_of_letters) {
               << " and " << max_number_of_letters
               << " letters, then press return (enter ! to quit): ";
     std::cin.getline(line, size_of_line);
+    if (std::cin.eof() && line[0] == GETLINE_TERMINATING_CHAR) {
+        std::cout << std::endl << "Exiting at the end of input" << std::endl;
+        return GET_LETTERS_FROM_CONSOLE_QUIT;
+    }
+    if (std::cin.fail() && !std::cin.eof()) {
+        //    the line was longer than the letters, the rest of it is discarded
+        //      so that the next entry starts on the next line
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
     int number_of_entered_letters = 0;
     for (unsigned i = 0; i != max_number_of_letters; i++) {
         switch(line[i]) {
         case GET_LETTERS_FROM_CONSOLE_QUIT_CHAR:
             letters.clear();
             std::cout << "Exiting due to '!'" << std::endl;
-            goto GET_LETTERS_RETURN;
+            return GET_LETTERS_FROM_CONSOLE_QUIT;
         case GETLINE_TERMINATING_CHAR:
             // '\0'
             goto GET_LETTERS_RETURN;
@@ -331,10 +836,40 @@ GET_LETTERS_RETURN:
     return letters.size();
 }
 
-void parseCommandLine(int &letters_arg_position, int &filename_arg_position, int argc, char **argv)
+std::unique_ptr<Dictionary> openDictionaryFile(const std::string &filename) {
+
+    if (CompiledDictionary::isCompiledDictionary(filename)) {
+        return std::make_unique<CompiledDictionary>(filename);
+    }
+
+    std::unique_ptr<Dictionary> dictionary = std::make_unique<MmapDictionary>(filename);
+    if (dictionary->isError()) {
+        //    files that cannot be mapped are read a line at a time
+        dictionary = std::make_unique<FileDictionary>(filename);
+    }
+    return dictionary;
+}
+
+
+void parseCommandLine(CommandLineArguments &arguments, int argc, char **argv)
 {
-    letters_arg_position  = USE_CONSOLE_FOR_LETTERS;
-    filename_arg_position = USE_DEFAULT_DICTIONARY;
+    arguments.letters_arg_position  = USE_CONSOLE_FOR_LETTERS;
+    arguments.filename_arg_position = USE_DEFAULT_DICTIONARY;
+    arguments.threads_arg_position  = USE_INDEXED_SEARCH;
+    arguments.compile_arg_position  = NOT_COMPILING_DICTIONARY;
+    arguments.serve_arg_position    = NOT_SERVING;
+    arguments.http_arg_position     = NOT_SERVING;
+    arguments.batch_arg_position    = NOT_BATCH;
+    arguments.center_arg_position   = USE_FIRST_LETTER_AS_CENTER;
+    arguments.rank_arg_position     = NOT_RANKING;
+    arguments.explore_arg_position  = NOT_EXPLORING;
+    arguments.engine_arg_position   = USE_DEFAULT_ENGINE;
+    arguments.benchmark_arg_position = NOT_BENCHMARKING;
+    arguments.use_index_cache       = true;
+    arguments.stream_batch          = false;
+    arguments.nyt_rules             = false;
+    arguments.all_centers           = false;
+    arguments.hints                 = false;
     bool print_help_menu = false;
 
     // argv[0] is the program name
@@ -348,15 +883,93 @@ void parseCommandLine(int &letters_arg_position, int &filename_arg_position, int
                 print_help_menu = true;
                 break;
             case LETTERS_TOKEN:
-                letters_arg_position = i+1;
+                arguments.letters_arg_position = i+1;
                 // move past the next token = letter list
                 i++;
                 break;
             case FILENAME_TOKEN:
-                filename_arg_position = i+1;
+                arguments.filename_arg_position = i+1;
                 // move past the next token = filename
                 i++;
                 break;
+            case THREADS_TOKEN:
+                if (i+1 < argc) {
+                    arguments.threads_arg_position = i+1;
+                } else {
+                    std::cout << "Missing number of threads after " << token << std::endl;
+                    print_help_menu = true;
+                }
+                // move past the next token = number of threads
+                i++;
+                break;
+            case ENGINE_TOKEN:
+                if (i+1 < argc) {
+                    arguments.engine_arg_position = i+1;
+                } else {
+                    std::cout << "Missing search engine after " << token << std::endl;
+                    print_help_menu = true;
+                }
+                // move past the next token = engine name
+                i++;
+                break;
+            case CENTER_TOKEN:
+                if (i+1 < argc) {
+                    arguments.center_arg_position = i+1;
+                    arguments.nyt_rules = true;
+                } else {
+                    std::cout << "Missing center letter after " << token << std::endl;
+                    print_help_menu = true;
+                }
+                // move past the next token = center letter
+                i++;
+                break;
+            case LONG_OPTION_TOKEN:
+                if (strcmp(token, COMPILE_DICTIONARY_OPTION) == 0 && i+2 < argc) {
+                    arguments.compile_arg_position = i+1;
+                    // move past the next two tokens = input and output filenames
+                    i += 2;
+                } else if (strcmp(token, SERVE_OPTION) == 0 && i+1 < argc) {
+                    arguments.serve_arg_position = i+1;
+                    // move past the next token = socket path
+                    i++;
+                } else if (strcmp(token, HTTP_OPTION) == 0 && i+1 < argc) {
+                    arguments.http_arg_position = i+1;
+                    // move past the next token = address:port
+                    i++;
+                } else if (strcmp(token, BATCH_OPTION) == 0 && i+1 < argc) {
+                    arguments.batch_arg_position = i+1;
+                    // move past the next token = filename
+                    i++;
+                } else if (strcmp(token, RANK_OPTION) == 0 && i+1 < argc) {
+                    arguments.rank_arg_position = i+1;
+                    // move past the next token = number of sets
+                    i++;
+                } else if (strcmp(token, EXPLORE_OPTION) == 0 && i+1 < argc) {
+                    arguments.explore_arg_position = i+1;
+                    // move past the next token = report filename
+                    i++;
+                } else if (strcmp(token, BENCHMARK_OPTION) == 0 && i+1 < argc) {
+                    arguments.benchmark_arg_position = i+1;
+                    // move past the next token = number of searches
+                    i++;
+                } else if (strcmp(token, NYT_RULES_OPTION) == 0) {
+                    arguments.nyt_rules = true;
+                } else if (strcmp(token, ALL_CENTERS_OPTION) == 0) {
+                    arguments.all_centers = true;
+                    arguments.nyt_rules = true;
+                } else if (strcmp(token, HINTS_OPTION) == 0) {
+                    arguments.hints = true;
+                    arguments.nyt_rules = true;
+                } else if (strcmp(token, STREAM_OPTION) == 0) {
+                    arguments.stream_batch = true;
+                } else if (strcmp(token, NO_CACHE_OPTION) == 0) {
+                    arguments.use_index_cache = false;
+                } else {
+                    std::cout << "Unrecognized command line switch: "
+                              << token << std::endl;
+                    print_help_menu = true;
+                }
+                break;
             default:
                 std::cout << "Unrecognized command line switch: "
                           << token << std::endl;
@@ -372,7 +985,7 @@ void parseCommandLine(int &letters_arg_position, int &filename_arg_position, int
 }
 
 
-void printDictionary(std::unique_ptr<Dictionary> &dictionary, int num_words_at_start) {
+void printDictionary(const LetterMaskIndex &index, int num_words_at_start) {
 
     // store iostream flags that will be modified using iomanip members
     std::ios_base::fmtflags _flags = std::cout.flags();
@@ -380,28 +993,151 @@ void printDictionary(std::unique_ptr<Dictionary> &dictionary, int num_words_at_s
     // improves readability
 
 //    int beginning_block_size = num_words_at_start;
-    dictionary->open();
-    dictionary->begining();
-
-    if (dictionary->isError()) {
-        std::cout << "dictionary in error state" << std::endl;
-        return;
-    }
-
-    for (int i = 0; i != num_words_at_start; i++) {
-        if (!dictionary->isNext())
-            break;
-        std::cout << std::setw(5) << std::right << i << ": "
-                  << dictionary->nextWord() << std::endl;
+    size_t num_words = std::min(index.size(), static_cast<size_t>(std::max(0, num_words_at_start)));
+    for (size_t i = 0; i != num_words; i++) {
+        std::cout << std::setw(WORD_NUMBER_PRINTED_WIDTH) << std::right << i << ": "
+                  << index.word(i) << std::endl;
     }
     std::cout << std::endl;
-    dictionary->begining();
 
     // restore iostream flags that were modified using iomanip members
     std::cout.flags(_flags);
 }
 
 
+void printEveryCenterMatches(const LetterMaskIndex &words, const Puzzle &puzzle, size_t puzzle_number,
+                             const std::vector<std::vector<word_id_t>> &matches) {
+
+    //    each letter once, in the order it was given
+    letter_mask_t printed = 0;
+    Puzzle centered = puzzle;
+    for (char letter : puzzle.letters) {
+        letter_mask_t bit = letterBit(letter);
+        if (bit & (printed | LetterMaskInvalid)) {
+            continue;
+        }
+        printed |= bit;
+        centered.center = letter;
+        printPuzzleMatches(words, centered, puzzle_number, matches[__builtin_ctz(bit)]);
+    }
+}
+
+
+void printHints(const DawgDictionary &dawg, const Puzzle &puzzle) {
+
+    //    only the answers under each prefix are walked, not the whole puzzle
+    std::cout << "Words by their first two letters:" << std::endl;
+    std::vector<word_id_t> matches;
+    std::string prefix(2, ' ');
+    for (letter_mask_t first = puzzle.allowed & AllLettersMask; first != 0; first &= first - 1) {
+        prefix[0] = 'a' + __builtin_ctz(first);
+        bool any_words = false;
+        for (letter_mask_t second = puzzle.allowed & AllLettersMask; second != 0; second &= second - 1) {
+            prefix[1] = 'a' + __builtin_ctz(second);
+            matches.clear();
+            size_t num_words = dawg.find(prefix, puzzle.min_length, puzzle.allowed,
+                                         puzzle.required, matches);
+            if (num_words != 0) {
+                std::cout << (any_words ? "  " : "    ") << prefix << '-' << num_words;
+                any_words = true;
+            }
+        }
+        if (any_words) {
+            std::cout << '\n';
+        }
+    }
+    std::cout << std::flush;
+}
+
+
+void printPuzzleMatches(const LetterMaskIndex &words, const Puzzle &puzzle, size_t puzzle_number,
+                        const std::vector<word_id_t> &matches) {
+
+    std::string letters_str = '"' + puzzle.letters + '"';
+    std::cout << "Puzzle " << puzzle_number << ": " << letters_str;
+    if (puzzle.center != PuzzleNoCenter) {
+        std::cout << " with center letter " << puzzle.center;
+    }
+    std::cout << '\n';
+
+    //    '\n' rather than std::endl, a batch can print millions of lines
+    int success_count = 0;
+    for (word_id_t id : matches) {
+        std::cout << std::setw(WORD_NUMBER_PRINTED_WIDTH)
+                  << ++success_count << ": "
+                  << letters_str << "   found in word   " << words.word(id) << '\n';
+    }
+    if (success_count == 0) {
+        std::cout << "No qualifying words found the dictionary" << '\n';
+    }
+    std::cout << '\n';
+}
+
+
+int rankLetterSets(const LetterMaskIndex &index, ThreadPool *thread_pool, size_t num_sets) {
+
+    //    without -j, every CPU is used to count
+    std::unique_ptr<ThreadPool> own_thread_pool;
+    if (!thread_pool) {
+        own_thread_pool = std::make_unique<ThreadPool>(0);
+        thread_pool = own_thread_pool.get();
+    }
+
+    std::cout << "Counting the words that can be made from every set of letters" << std::endl;
+    SubsetCounts counts;
+    counts.build(index, PuzzleNytMinWordLength, thread_pool);
+
+    std::vector<RankedLetterSet> sets = counts.rank(MAX_NUMBER_OF_LETTERS, num_sets);
+    std::cout << "The " << sets.size() << " sets of " << MAX_NUMBER_OF_LETTERS
+              << " letters and a center letter with the most words of at least "
+              << counts.minLength() << " letters" << std::endl << std::endl;
+    for (size_t i = 0; i != sets.size(); i++) {
+        std::cout << std::setw(WORD_NUMBER_PRINTED_WIDTH) << i+1 << ": \""
+                  << letterString(sets[i].letters) << " " << letterString(sets[i].center)
+                  << "\"   " << sets[i].count << " words\n";
+    }
+
+    std::cout << std::endl << "SpellingBeeSolver completed" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+
+bool readPuzzleFile(const std::string &filename, std::vector<Puzzle> &puzzles) {
+
+    if (filename == BATCH_FROM_STANDARD_INPUT) {
+        readPuzzles(std::cin, puzzles);
+        return true;
+    }
+
+    std::ifstream file(filename);
+    if (!file) {
+        std::cout << "Unable to open puzzle file " << filename << std::endl;
+        return false;
+    }
+    readPuzzles(file, puzzles);
+    return true;
+}
+
+
+void readPuzzles(std::istream &input, std::vector<Puzzle> &puzzles) {
+
+    std::string line;
+    Puzzle puzzle;
+    for (size_t line_number = 1; std::getline(input, line); line_number++) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == BATCH_COMMENT_CHAR) {
+            continue;
+        }
+        if (parsePuzzle(line, MINIMUM_MAX_NUMBER_OF_LETTERS_TO_SEARCH_FOR,
+                        MAX_NUMBER_OF_LETTERS, puzzle)) {
+            puzzles.push_back(puzzle);
+        } else {
+            std::cout << "Ignoring line " << line_number << ": \"" << line << "\"" << std::endl;
+        }
+    }
+}
+
+
 void removeDuplicateLetters(letters_t &letters) {
 
     int last_letter_position = letters.size()-1;
@@ -426,3 +1162,153 @@ void removeDuplicateLetters(letters_t &letters) {
         }
     }
 }
+
+
+void searchForLetters(Solver &solver, letters_t &letters, size_t minimum_number_of_letters,
+                      bool nyt_rules, char center, bool all_centers, const DawgDictionary *hints) {
+
+    removeDuplicateLetters(letters);
+    std::string letters_str("\"");
+    for (size_t i = 0; i != letters.size(); i++) {
+        letters_str += letters[i];
+    }
+    letters_str += '"';
+
+    if (letters.size() >= minimum_number_of_letters) {
+        //    every letter is required and no other letters are allowed,
+        //      unless the NYT rules are followed
+        Puzzle puzzle = makePuzzle(std::string_view(letters.data(), letters.size()));
+        if (center != PuzzleNoCenter && (letterBit(center) & puzzle.allowed) == 0) {
+            std::cout << "Error: The center letter must be one of the puzzle letters, not "
+                      << center << std::endl;
+            return;
+        }
+        if (all_centers) {
+            applyNytRules(puzzle, center);
+            std::cout << "Searching for words of at least " << puzzle.min_length
+                      << " letters for every choice of center letter from these letters:    "
+                      << letters_str << std::endl << std::endl;
+            std::vector<std::vector<word_id_t>> matches;
+            solver.findEveryCenter(puzzle, matches);
+            printEveryCenterMatches(solver.index(), puzzle, 1, matches);
+            std::cout << std::flush;
+            return;
+        }
+        if (nyt_rules) {
+            applyNytRules(puzzle, center);
+            std::cout << "Searching for words of at least " << puzzle.min_length
+                      << " letters that use the center letter " << puzzle.center
+                      << " and any of these letters:    ";
+        } else {
+            std::cout << "Searching for words that contain all of these and only these letters:    ";
+        }
+        std::cout << letters_str << std::endl << std::endl;
+        int success_count = 0;
+        std::vector<word_id_t> matches;
+
+        solver.find(puzzle, matches);
+        for (word_id_t id : matches) {
+            std::cout << std::setw(WORD_NUMBER_PRINTED_WIDTH)
+                      << ++success_count << ": "
+                      << letters_str << "   found in word   " << solver.word(id) << std::endl;
+        }
+        if (success_count == 0) {
+            std::cout << "No qualifying words found the dictionary" << std::endl;
+        }
+        if (hints) {
+            std::cout << std::endl;
+            printHints(*hints, puzzle);
+        }
+    } else {
+        // there were an insufficient number of letters to search for, an empty entry is not an error
+        if (letters.size() > 0) {
+            std::cout << "Error: Only " << letters.size()
+                      << " letters will result in too many matches." << std::endl
+                      << "       Not performing search" << std::endl;
+        }
+    }
+}
+
+
+int scanBatch(Dictionary &dictionary, const std::string &filename, bool nyt_rules,
+              bool all_centers) {
+
+    std::vector<Puzzle> puzzles;
+    if (!readPuzzleFile(filename, puzzles)) {
+        return EXIT_FAILURE;
+    }
+    for (Puzzle &puzzle : puzzles) {
+        if (nyt_rules) {
+            applyNytRules(puzzle, PuzzleNoCenter);
+        }
+    }
+    std::cout << "Solving " << puzzles.size()
+              << " puzzles in one pass over the dictionary" << std::endl << std::endl;
+
+    //    for every center letter, a query finds all of the words made of the
+    //      letters, which are then given to each of the letters they use
+    MultiQueryScanner scanner;
+    for (const Puzzle &puzzle : puzzles) {
+        scanner.addQuery(puzzle.allowed, all_centers ? 0 : puzzle.required, puzzle.min_length);
+    }
+    if (!scanner.scan(dictionary)) {
+        std::cout << "Error reading the dictionary after " << scanner.wordsScanned()
+                  << " words" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::vector<word_id_t>> center_matches(NumberOfLetters);
+    for (size_t i = 0; i != puzzles.size(); i++) {
+        if (!all_centers) {
+            printPuzzleMatches(scanner.words(), puzzles[i], i+1, scanner.matches(i));
+            continue;
+        }
+        for (std::vector<word_id_t> &letter_matches : center_matches) {
+            letter_matches.clear();
+        }
+        for (word_id_t id : scanner.matches(i)) {
+            for (letter_mask_t bits = scanner.words().mask(id); bits != 0; bits &= bits - 1) {
+                center_matches[__builtin_ctz(bits)].push_back(id);
+            }
+        }
+        printEveryCenterMatches(scanner.words(), puzzles[i], i+1, center_matches);
+    }
+
+    std::cout << "SpellingBeeSolver completed" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+
+int solveBatch(Solver &solver, const std::string &filename, bool nyt_rules, bool all_centers) {
+
+    //    every puzzle is read before any is solved
+    std::vector<Puzzle> puzzles;
+    if (!readPuzzleFile(filename, puzzles)) {
+        return EXIT_FAILURE;
+    }
+    for (Puzzle &puzzle : puzzles) {
+        if (nyt_rules) {
+            applyNytRules(puzzle, PuzzleNoCenter);
+        }
+    }
+    std::cout << "Solving " << puzzles.size() << " puzzles" << std::endl << std::endl;
+
+    std::vector<word_id_t> matches;
+    std::vector<std::vector<word_id_t>> center_matches;
+    for (size_t i = 0; i != puzzles.size(); i++) {
+        if (all_centers) {
+            for (std::vector<word_id_t> &letter_matches : center_matches) {
+                letter_matches.clear();
+            }
+            solver.findEveryCenter(puzzles[i], center_matches);
+            printEveryCenterMatches(solver.index(), puzzles[i], i+1, center_matches);
+            continue;
+        }
+        matches.clear();
+        solver.find(puzzles[i], matches);
+        printPuzzleMatches(solver.index(), puzzles[i], i+1, matches);
+    }
+
+    std::cout << "SpellingBeeSolver completed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -8,6 +8,7 @@
 #ifndef SPELLINGBEESOLVER_H_
 #define SPELLINGBEESOLVER_H_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -16,5 +17,9 @@ typedef char letter_t;
 typedef std::vector<letter_t> letters_t;
 typedef std::string word_t;
 typedef unsigned long dictionary_size_t;
+// bit (letter - 'a') is set for every letter that appears in a word
+typedef uint32_t letter_mask_t;
+typedef uint32_t word_id_t;
+typedef uint16_t word_length_t;
 
 #endif /* SPELLINGBEESOLVER_H_ */
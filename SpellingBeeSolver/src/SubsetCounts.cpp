@@ -0,0 +1,155 @@
+/*
+ * SubsetCounts.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "SubsetCounts.h"
+
+#include <algorithm>
+#include <cstring>
+
+constexpr size_t SubsetCountsSize = size_t(1) << NumberOfLetters;
+constexpr size_t SubsetCountsBlockSize = size_t(1) << SubsetCountsBlockBits;
+constexpr size_t SubsetCountsNumBlocks = SubsetCountsSize / SubsetCountsBlockSize;
+
+SubsetCounts::SubsetCounts() :
+	m_min_length(0) {}
+
+void SubsetCounts::build(const LetterMaskIndex &index, word_length_t min_length,
+						 ThreadPool *pool) {
+
+	m_counts.assign(SubsetCountsSize, 0);
+	m_min_length = min_length;
+
+	for (size_t i = 0; i != index.size(); i++) {
+		letter_mask_t mask = index.mask(i);
+		if ((mask & LetterMaskInvalid) == 0 && index.length(i) >= min_length)
+			m_counts[mask]++;
+	}
+
+	sumOverSubsets(pool);
+}
+
+void SubsetCounts::clear(void) {
+
+	m_counts.clear();
+	m_counts.shrink_to_fit();
+	m_min_length = 0;
+}
+
+// for each bit in turn, every mask with the bit set is given the count
+//	of the same mask without it.  The low bits only pair up counts within
+//	a block, so each block is summed on its own.  The high bits pair up
+//	whole blocks, so those are summed a narrow stripe of every block at
+//	a time.  The blocks are a power of two apart, which would put all of
+//	a stripe in the same few cache sets, so it is copied out to be summed
+void SubsetCounts::sumOverSubsets(ThreadPool *pool) {
+
+	uint32_t *counts = m_counts.data();
+
+	auto sum_block = [counts](size_t block) {
+		uint32_t *first = counts + block * SubsetCountsBlockSize;
+		// the three lowest bits are summed eight counts at a time,
+		//	the rest pair up runs that are long enough to vectorize
+		for (size_t i = 0; i != SubsetCountsBlockSize; i += 8) {
+			uint32_t *c = first + i;
+			c[1] += c[0];	c[3] += c[2];	c[5] += c[4];	c[7] += c[6];
+			c[2] += c[0];	c[3] += c[1];	c[6] += c[4];	c[7] += c[5];
+			c[4] += c[0];	c[5] += c[1];	c[6] += c[2];	c[7] += c[3];
+		}
+		for (size_t half = 8; half != SubsetCountsBlockSize; half *= 2) {
+			for (size_t pair = 0; pair != SubsetCountsBlockSize; pair += 2 * half) {
+				for (size_t i = 0; i != half; i++) {
+					first[pair + half + i] += first[pair + i];
+				}
+			}
+		}
+	};
+
+	auto sum_stripe = [counts](size_t stripe) {
+		std::vector<uint32_t> rows(SubsetCountsNumBlocks * SubsetCountsStripeWidth);
+		uint32_t *first = counts + stripe * SubsetCountsStripeWidth;
+		for (size_t block = 0; block != SubsetCountsNumBlocks; block++) {
+			memcpy(&rows[block * SubsetCountsStripeWidth], first + block * SubsetCountsBlockSize,
+				   SubsetCountsStripeWidth * sizeof(uint32_t));
+		}
+		for (size_t half = 1; half != SubsetCountsNumBlocks; half *= 2) {
+			for (size_t pair = 0; pair != SubsetCountsNumBlocks; pair += 2 * half) {
+				uint32_t *to = &rows[(pair + half) * SubsetCountsStripeWidth];
+				const uint32_t *from = &rows[pair * SubsetCountsStripeWidth];
+				for (size_t i = 0; i != half * SubsetCountsStripeWidth; i++) {
+					to[i] += from[i];
+				}
+			}
+		}
+		for (size_t block = 0; block != SubsetCountsNumBlocks; block++) {
+			memcpy(first + block * SubsetCountsBlockSize, &rows[block * SubsetCountsStripeWidth],
+				   SubsetCountsStripeWidth * sizeof(uint32_t));
+		}
+	};
+
+	size_t num_stripes = SubsetCountsBlockSize / SubsetCountsStripeWidth;
+	if (pool) {
+		pool->run(SubsetCountsNumBlocks, sum_block);
+		pool->run(num_stripes, sum_stripe);
+	} else {
+		for (size_t block = 0; block != SubsetCountsNumBlocks; block++) {
+			sum_block(block);
+		}
+		for (size_t stripe = 0; stripe != num_stripes; stripe++) {
+			sum_stripe(stripe);
+		}
+	}
+}
+
+uint32_t SubsetCounts::count(letter_mask_t allowed, letter_mask_t required) const {
+
+	allowed &= AllLettersMask;
+	if ((required & ~allowed) != 0)
+		return 0;
+
+	// the words missing any of the letters in a subset of 'required'
+	//	are alternately taken away and added back
+	int64_t total = 0;
+	letter_mask_t missing = required;
+	while (true) {
+		int64_t words = m_counts[allowed & ~missing];
+		total += numberOfLetters(missing) % 2 == 0 ? words : -words;
+		if (missing == 0)
+			break;
+		missing = (missing - 1) & required;
+	}
+	return static_cast<uint32_t>(total);
+}
+
+std::vector<RankedLetterSet> SubsetCounts::rank(int num_letters, size_t num_sets) const {
+
+	std::vector<RankedLetterSet> sets;
+	if (!isBuilt() || num_letters <= 0 || num_letters > NumberOfLetters)
+		return sets;
+
+	// every mask with 'num_letters' bits set, in increasing order
+	uint64_t letters = (uint64_t(1) << num_letters) - 1;
+	while (letters <= AllLettersMask) {
+		letter_mask_t mask = static_cast<letter_mask_t>(letters);
+		for (letter_mask_t centers = mask; centers != 0; centers &= centers - 1) {
+			letter_mask_t center = centers & -centers;
+			sets.push_back({ mask, center, count(mask, center) });
+		}
+		uint64_t lowest = letters & -letters;
+		uint64_t carried = letters + lowest;
+		letters = (((carried ^ letters) >> 2) / lowest) | carried;
+	}
+
+	auto more_words = [](const RankedLetterSet &a, const RankedLetterSet &b) {
+		if (a.count != b.count)
+			return a.count > b.count;
+		return a.letters != b.letters ? a.letters < b.letters : a.center < b.center;
+	};
+	num_sets = std::min(num_sets, sets.size());
+	std::partial_sort(sets.begin(), sets.begin() + num_sets, sets.end(), more_words);
+	sets.resize(num_sets);
+	return sets;
+}
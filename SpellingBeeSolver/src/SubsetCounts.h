@@ -0,0 +1,81 @@
+/*
+ * SubsetCounts.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef SUBSETCOUNTS_H_
+#define SUBSETCOUNTS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "LetterMask.h"
+#include "LetterMaskIndex.h"
+#include "SpellingBeeSolver.h"
+#include "ThreadPool.h"
+
+// the low bits of a mask that are summed within one block of counts,
+//	2^16 counts is 256KB, which stays in the cache while it is summed
+constexpr int SubsetCountsBlockBits = 16;
+// the number of neighboring counts in each block that are summed
+//	together across the high bits, 64 bytes from each of the 2^10 blocks
+constexpr int SubsetCountsStripeWidth = 16;
+
+// One set of letters, with the center letter every word must use,
+//	and the number of words that can be made from it
+struct RankedLetterSet {
+	letter_mask_t letters;
+	// the bit of the center letter, which is one of 'letters'
+	letter_mask_t center;
+	uint32_t count;
+};
+
+// The number of words that can be made from every one of the 2^26 sets
+//	of letters, so that any set can be looked up instead of searched for
+//
+//	Every word is counted at its own distinct-letter mask, then a
+//	sum over subsets adds each count to all of the sets that contain
+//	that mask: after that, m_counts[letters] is the number of words
+//	that use only 'letters'.  The table takes 256MB
+class SubsetCounts {
+private:
+	std::vector<uint32_t> m_counts;
+	word_length_t m_min_length;
+
+	// adds the count of every mask to each of its supersets
+	void sumOverSubsets(ThreadPool *pool);
+
+public:
+	SubsetCounts();
+	virtual ~SubsetCounts() {}
+
+	SubsetCounts(const SubsetCounts &other) = delete;
+	SubsetCounts& operator=(const SubsetCounts &other) = delete;
+
+	// counts the words of 'index' that have at least 'min_length' letters,
+	//	words containing a character that is not a letter are not counted
+	//	the sums are split across the threads of 'pool', which may be nullptr
+	void build(const LetterMaskIndex &index, word_length_t min_length, ThreadPool *pool);
+	void clear(void);
+	bool isBuilt(void) const				{ return !m_counts.empty(); }
+	word_length_t minLength(void) const		{ return m_min_length; }
+
+	// the number of words that only use letters in 'allowed'
+	uint32_t count(letter_mask_t allowed) const {
+		return m_counts[allowed & AllLettersMask];
+	}
+	// the number of words that only use letters in 'allowed' and use every
+	//	letter in 'required', by inclusion and exclusion over 'required'
+	uint32_t count(letter_mask_t allowed, letter_mask_t required) const;
+
+	// ranks every set of 'num_letters' letters, with each of its letters
+	//	as the center letter, by the number of words that can be made from
+	//	it and use the center letter, and returns the 'num_sets' with the
+	//	most.  Sets with the same count are in increasing order of their
+	//	masks, then of their center letters
+	std::vector<RankedLetterSet> rank(int num_letters, size_t num_sets) const;
+};
+
+#endif /* SUBSETCOUNTS_H_ */
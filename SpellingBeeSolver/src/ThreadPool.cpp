@@ -0,0 +1,95 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned num_threads) :
+	m_task(nullptr),
+	m_num_tasks(0),
+	m_next_task(0),
+	m_num_busy(0),
+	m_job(0),
+	m_stop(false) {
+
+	if (num_threads == 0)
+		num_threads = std::thread::hardware_concurrency();
+
+	// the calling thread is the first thread of the pool
+	for (unsigned i = 1; i < num_threads; i++) {
+		m_threads.emplace_back(&ThreadPool::worker, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_start.notify_all();
+
+	for (std::thread &thread : m_threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::run(size_t num_tasks, const std::function<void(size_t task)> &task) {
+
+	if (num_tasks == 0)
+		return;
+
+	if (m_threads.empty()) {
+		for (size_t i = 0; i != num_tasks; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_num_tasks = num_tasks;
+		m_next_task = 0;
+		m_num_busy = m_threads.size();
+		m_job++;
+	}
+	m_start.notify_all();
+
+	runTasks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_num_busy == 0; });
+	m_task = nullptr;
+}
+
+void ThreadPool::runTasks(void) {
+
+	size_t task;
+	while ((task = m_next_task.fetch_add(1)) < m_num_tasks) {
+		(*m_task)(task);
+	}
+}
+
+void ThreadPool::worker(void) {
+
+	unsigned long last_job = 0;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_start.wait(lock, [this, last_job] { return m_stop || m_job != last_job; });
+		if (m_stop)
+			return;
+		last_job = m_job;
+
+		lock.unlock();
+		runTasks();
+		lock.lock();
+
+		if (--m_num_busy == 0)
+			m_done.notify_all();
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that run the numbered tasks of one job
+//	at a time.  Tasks are handed out in order from a shared counter, so
+//	a thread that finishes a task early simply takes the next one.
+//	The thread that calls run() works on the job too
+class ThreadPool {
+private:
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_start;
+	std::condition_variable m_done;
+
+	// the current job, only valid while run() is executing
+	const std::function<void(size_t)> *m_task;
+	size_t m_num_tasks;
+	std::atomic<size_t> m_next_task;
+	// number of worker threads that have not finished the current job
+	size_t m_num_busy;
+	// incremented for every job, so workers can tell a new job has started
+	unsigned long m_job;
+	bool m_stop;
+
+	void worker(void);
+	void runTasks(void);
+
+public:
+	// 'num_threads' includes the thread calling run(), 0 means one
+	//	thread per hardware thread
+	ThreadPool(unsigned num_threads);
+	virtual ~ThreadPool();
+
+	ThreadPool(const ThreadPool &other) = delete;
+	ThreadPool& operator=(const ThreadPool &other) = delete;
+
+	// the number of threads that work on a job
+	unsigned size(void) const	{ return m_threads.size() + 1; }
+
+	// calls task(0) .. task(num_tasks-1), in parallel, and returns when
+	//	all of them have completed.  Only one job may run at a time
+	void run(size_t num_tasks, const std::function<void(size_t task)> &task);
+};
+
+#endif /* THREADPOOL_H_ */
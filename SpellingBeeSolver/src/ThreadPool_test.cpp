@@ -0,0 +1,9 @@
+/*
+ * ThreadPool_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: joe
+ */
+
+#include "ThreadPool.h"
+